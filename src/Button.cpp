@@ -1,13 +1,23 @@
 #include "Button.h"
 #include "raylib.h"
 
-Button::Button(const Font& font, const std::string& text, Vector2 pos, Vector2 sizeOpt) : font(font), pos(pos), text(text) {
+Button::Button(const Font& font, const std::string& text, Vector2 pos, Vector2 sizeOpt) : font(font), offset(pos), pos(pos), sizeOpt(sizeOpt), text(text) {
+    measure();
+}
+
+void Button::measure() {
     float spacing = 1.0f;
-    Vector2 textSize = MeasureTextEx(font, text.c_str(), font.baseSize, spacing);
+    textSize = MeasureTextLine(font, text, spacing);
     size.x = sizeOpt.x == 0 ? textSize.x + 20.0f : sizeOpt.x;
     size.y = sizeOpt.y == 0 ? textSize.y + 10.0f : sizeOpt.y;
 }
 
+void Button::setText(const std::string& newText) {
+    if (newText == text) return;
+    text = newText;
+    measure();
+}
+
 void Button::draw() const {
     Color bgColor, fgColor;
     switch (state) {
@@ -17,18 +27,16 @@ void Button::draw() const {
     }
 
     DrawRectangleRounded({ pos.x, pos.y, size.x, size.y }, 1.0f, 10, bgColor);
-    DrawTextCenter(font, text, { pos.x + size.x / 2, pos.y + size.y / 2 }, fgColor);
+    DrawTextAnchor(font, text, { pos.x + size.x / 2, pos.y + size.y / 2 }, textSize, 0, 0, fgColor);
 }
 
-void Button::update(const Vector2& mousePos) {
-    onUpdate(*this);
-
+void Button::press() {
     if (state == State::DISABLED) return;
 
-    if (isClicked(mousePos)) {
-        click();
-    }
-    if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
-        unclick();
-    }
+    state = State::CLICKED;
+    onClick();
+}
+
+void Button::release() {
+    if (state != State::DISABLED) state = State::IDLE;
 }
\ No newline at end of file
@@ -17,7 +17,17 @@ struct Button {
 
     Button(const Font& font, const std::string& text, Vector2 pos, Vector2 sizeOpt);
     void draw() const;
-    void update(const Vector2& mousePos);
+
+    // called by Layout when the mouse is pressed over / released anywhere after pressing this button
+    void press();
+    void release();
+
+    // re-measures the text, so the owning Layout has to be invalidated afterwards
+    void setText(const std::string& newText);
+
+    Rectangle getRect() const {
+        return { pos.x, pos.y, size.x, size.y };
+    }
 
     void disable() {
         state = State::DISABLED;
@@ -29,23 +39,15 @@ struct Button {
 
     State state = State::IDLE;
     const Font& font;
+    LayoutAnchor layoutAnchor = LayoutAnchor::SCREEN;
+    Vector2 offset;
     Vector2 pos;
     Vector2 size;
+    Vector2 sizeOpt;
+    Vector2 textSize;
     std::string text;
     std::function<void()> onClick = [](){};
-    std::function<void(Button&)> onUpdate = [](Button& thiz){};
 
 private:
-    void unclick() {
-        if (state != State::DISABLED) state = State::IDLE;
-    }
-
-    void click() {
-        state = State::CLICKED;
-        onClick();
-    }
-
-    bool isClicked(const Vector2& mousePos) const {
-        return IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInRect(mousePos, pos, size);
-    }
+    void measure();
 };
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include "Curve.h"
+
+#include <algorithm>
+#include <cmath>
+
+// credit to https://github.com/gdkchan/SPICA/blob/42c4181e198b0fd34f0a567345ee7e75b54cb58b/SPICA/Formats/CtrH3D/Animation/H3DFloatKeyFrameGroup.cs
+float HermiteInterpolate(float y_0, float y_1, float m_0, float m_1, float diff, float weight) {
+    float result;
+
+    result = y_0 + (y_0 - y_1) * (2 * weight - 3) * weight * weight;
+    result += (diff * (weight - 1)) * (m_0 * (weight - 1) + m_1 * weight);
+
+    return result;
+}
+
+// HermiteInterpolate expanded into a * t^3 + b * t^2 + c * t + y_0, for t in 0..1
+static void GetSegmentCoefficients(const KeyFrame& left, const KeyFrame& right, float span, float& a, float& b, float& c) {
+    float diff = left.value - right.value;
+    a = 2 * diff + span * (left.slope + right.slope);
+    b = -3 * diff - span * (2 * left.slope + right.slope);
+    c = span * left.slope;
+}
+
+// Value and slope of a single segment, one specialization per interpolation mode. The loops below are
+// instantiated once per kernel, so the mode is only looked at once per curve and never per sample.
+template <Interpolation Mode>
+struct SegmentKernel;
+
+template <>
+struct SegmentKernel<Interpolation::STEP> {
+    static float value(const KeyFrame& left, const KeyFrame&, float, float) {
+        return left.value;
+    }
+    static float slope(const KeyFrame&, const KeyFrame&, float, float) {
+        return 0.0f;
+    }
+};
+
+template <>
+struct SegmentKernel<Interpolation::LINEAR> {
+    static float value(const KeyFrame& left, const KeyFrame& right, float, float weight) {
+        return left.value + (right.value - left.value) * weight;
+    }
+    static float slope(const KeyFrame& left, const KeyFrame& right, float span, float) {
+        return (right.value - left.value) / span;
+    }
+};
+
+template <>
+struct SegmentKernel<Interpolation::HERMITE> {
+    static float value(const KeyFrame& left, const KeyFrame& right, float frameDiff, float weight) {
+        return HermiteInterpolate(left.value, right.value, left.slope, right.slope, frameDiff, weight);
+    }
+    static float slope(const KeyFrame& left, const KeyFrame& right, float span, float weight) {
+        float a, b, c;
+        GetSegmentCoefficients(left, right, span, a, b, c);
+        return (3 * a * weight * weight + 2 * b * weight + c) / span;
+    }
+};
+
+// calls function with the kernel for the given mode
+template <typename Function>
+static auto WithKernel(Interpolation interpolation, Function&& function) {
+    switch (interpolation) {
+        case Interpolation::STEP: return function(SegmentKernel<Interpolation::STEP>{});
+        case Interpolation::LINEAR: return function(SegmentKernel<Interpolation::LINEAR>{});
+        default: return function(SegmentKernel<Interpolation::HERMITE>{});
+    }
+}
+
+const char* GetInterpolationName(Interpolation interpolation) {
+    switch (interpolation) {
+        case Interpolation::STEP: return "Step";
+        case Interpolation::LINEAR: return "Linear";
+        default: return "Hermite";
+    }
+}
+
+template <typename Kernel>
+static void SampleSegments(const std::vector<KeyFrame>& keyframes, float startFrame, float frameStep, int count, float* out) {
+    const KeyFrame& first = keyframes.front();
+    const KeyFrame& last = keyframes.back();
+
+    // samples outside the keyframes hold the end values, so they are filled up front and the loop
+    // below only ever sees frames strictly inside the curve
+    int begin = 0;
+    while (begin < count && startFrame + begin * frameStep <= first.frame)
+        out[begin++] = first.value;
+
+    int end = count;
+    while (end > begin && startFrame + (end - 1) * frameStep >= last.frame)
+        out[--end] = last.value;
+
+    size_t segment = 0;
+    for (int i = begin; i < end; i++) {
+        float frame = startFrame + i * frameStep;
+        while (keyframes[segment + 1].frame <= frame) segment++;
+
+        const KeyFrame& left = keyframes[segment];
+        const KeyFrame& right = keyframes[segment + 1];
+        float frameDiff = frame - left.frame;
+        out[i] = Kernel::value(left, right, frameDiff, frameDiff / (right.frame - left.frame));
+    }
+}
+
+void SampleCurve(const std::vector<KeyFrame>& keyframes, Interpolation interpolation, float startFrame, float frameStep, int count, float* out) {
+    if (keyframes.empty()) {
+        std::fill(out, out + count, 0.0f);
+        return;
+    }
+
+    // the segment walk only moves forward, so negative steps are sampled from the other end and flipped
+    if (frameStep < 0.0f) {
+        SampleCurve(keyframes, interpolation, startFrame + (count - 1) * frameStep, -frameStep, count, out);
+        std::reverse(out, out + count);
+        return;
+    }
+
+    WithKernel(interpolation, [&](auto kernel) {
+        SampleSegments<decltype(kernel)>(keyframes, startFrame, frameStep, count, out);
+    });
+}
+
+template <typename Kernel>
+static std::vector<KeyFrame> ResampleSegments(const std::vector<KeyFrame>& keyframes, int step) {
+    int firstFrame = keyframes.front().frame;
+    int lastFrame = keyframes.back().frame;
+
+    std::vector<KeyFrame> result;
+    result.reserve((lastFrame - firstFrame) / step + 2);
+
+    size_t segment = 0;
+    for (int frame = firstFrame; ; frame = std::min(frame + step, lastFrame)) {
+        while (segment + 2 < keyframes.size() && keyframes[segment + 1].frame <= frame) segment++;
+
+        const KeyFrame& left = keyframes[segment];
+        const KeyFrame& right = keyframes[segment + 1];
+        float span = right.frame - left.frame;
+
+        if (span <= 0.0f) {
+            result.push_back({ frame, right.value, right.slope });
+        } else {
+            float t = std::clamp((frame - left.frame) / span, 0.0f, 1.0f);
+            // step segments only take the right value once they reach it, which the last keyframe does
+            float value = frame >= right.frame ? right.value : Kernel::value(left, right, t * span, t);
+            result.push_back({ frame, value, Kernel::slope(left, right, span, t) });
+        }
+
+        if (frame == lastFrame) break;
+    }
+
+    return result;
+}
+
+std::vector<KeyFrame> ResampleCurve(const std::vector<KeyFrame>& keyframes, int step, Interpolation interpolation) {
+    if (keyframes.size() < 2 || step < 1) return keyframes;
+
+    return WithKernel(interpolation, [&](auto kernel) {
+        return ResampleSegments<decltype(kernel)>(keyframes, step);
+    });
+}
+
+// whether joining left straight to right stays within tolerance of the original at every frame between them
+template <typename Kernel>
+static bool FitsOriginal(const KeyFrame& left, const KeyFrame& right, float tolerance, const std::vector<float>& original, int firstFrame) {
+    float span = right.frame - left.frame;
+    if (span <= 0.0f) return false;
+
+    for (int frame = left.frame + 1; frame < right.frame; frame++) {
+        float frameDiff = frame - left.frame;
+        float value = Kernel::value(left, right, frameDiff, frameDiff / span);
+        if (std::abs(value - original[frame - firstFrame]) > tolerance) return false;
+    }
+    return true;
+}
+
+template <typename Kernel>
+static std::vector<KeyFrame> SimplifySegments(const std::vector<KeyFrame>& keyframes, float tolerance, const std::vector<float>& original, const std::function<bool(float)>& onProgress) {
+    int firstFrame = keyframes.front().frame;
+    size_t last = keyframes.size() - 1;
+    auto fits = [&](size_t from, size_t to) {
+        return FitsOriginal<Kernel>(keyframes[from], keyframes[to], tolerance, original, firstFrame);
+    };
+
+    std::vector<KeyFrame> result;
+    result.push_back(keyframes.front());
+
+    size_t kept = 0;
+    size_t nextProgress = 1024;
+    while (kept < last) {
+        // a half finished result would have everything after this point missing
+        if (onProgress && kept >= nextProgress) {
+            if (!onProgress((float)kept / keyframes.size())) return keyframes;
+            nextProgress = kept + 1024;
+        }
+
+        // the next keyframe always fits, being the original segment. probe further ahead in doubling
+        // strides until one doesn't, then binary search between the two, so a run of n dropped keyframes
+        // costs O(n log n) frame checks instead of the O(n^2) of trying every keyframe in turn
+        size_t good = kept + 1;
+        size_t bad = last + 1;
+        for (size_t stride = 1; good < last; stride *= 2) {
+            size_t probe = std::min(good + stride, last);
+            if (!fits(kept, probe)) {
+                bad = probe;
+                break;
+            }
+            good = probe;
+        }
+
+        while (bad - good > 1) {
+            size_t mid = good + (bad - good) / 2;
+            if (fits(kept, mid))
+                good = mid;
+            else
+                bad = mid;
+        }
+
+        result.push_back(keyframes[good]);
+        kept = good;
+    }
+
+    return result;
+}
+
+std::vector<KeyFrame> SimplifyCurve(const std::vector<KeyFrame>& keyframes, float tolerance, Interpolation interpolation, const std::function<bool(float)>& onProgress) {
+    if (keyframes.size() < 3) return keyframes;
+
+    int firstFrame = keyframes.front().frame;
+    std::vector<float> original(keyframes.back().frame - firstFrame + 1);
+    SampleCurve(keyframes, interpolation, firstFrame, 1.0f, original.size(), original.data());
+
+    return WithKernel(interpolation, [&](auto kernel) {
+        return SimplifySegments<decltype(kernel)>(keyframes, tolerance, original, onProgress);
+    });
+}
+
+ValueRange GetSegmentRange(const KeyFrame& left, const KeyFrame& right, Interpolation interpolation) {
+    ValueRange range = { std::min(left.value, right.value), std::max(left.value, right.value) };
+
+    // step and linear segments never leave the range of their end points
+    float span = right.frame - left.frame;
+    if (span <= 0.0f || interpolation != Interpolation::HERMITE) return range;
+
+    float a, b, c;
+    GetSegmentCoefficients(left, right, span, a, b, c);
+
+    auto include = [&](float t) {
+        if (t <= 0.0f || t >= 1.0f) return;
+        float value = HermiteInterpolate(left.value, right.value, left.slope, right.slope, t * span, t);
+        range.min = std::min(range.min, value);
+        range.max = std::max(range.max, value);
+    };
+
+    // roots of the derivative 3a * t^2 + 2b * t + c
+    if (std::abs(a) < 1e-6f) {
+        if (std::abs(b) > 1e-6f) include(-c / (2 * b));
+        return range;
+    }
+
+    float discriminant = b * b - 3 * a * c;
+    if (discriminant < 0.0f) return range;
+
+    float root = std::sqrt(discriminant);
+    include((-b + root) / (3 * a));
+    include((-b - root) / (3 * a));
+
+    return range;
+}
+
+void CurveBounds::rebuild(const std::vector<KeyFrame>& keyframes, Interpolation interpolation) {
+    this->interpolation = interpolation;
+    segments.clear();
+
+    if (keyframes.empty()) {
+        total = { 0.0f, 0.0f };
+        return;
+    }
+
+    if (keyframes.size() == 1) {
+        segments.push_back({ keyframes[0].value, keyframes[0].value });
+    } else {
+        segments.reserve(keyframes.size() - 1);
+        for (size_t i = 0; i + 1 < keyframes.size(); i++)
+            segments.push_back(GetSegmentRange(keyframes[i], keyframes[i + 1], interpolation));
+    }
+
+    refold();
+}
+
+void CurveBounds::update(const std::vector<KeyFrame>& keyframes, int keyframeIndex) {
+    if (keyframes.size() < 2 || segments.size() != keyframes.size() - 1) {
+        rebuild(keyframes, interpolation);
+        return;
+    }
+
+    // only the segments on either side of the keyframe change
+    bool shrunk = false;
+    int first = std::max(keyframeIndex - 1, 0);
+    int last = std::min(keyframeIndex, (int)segments.size() - 1);
+    for (int i = first; i <= last; i++) {
+        ValueRange oldRange = segments[i];
+        segments[i] = GetSegmentRange(keyframes[i], keyframes[i + 1], interpolation);
+
+        // a segment that used to define the bound moved inwards, so the bound has to be searched again
+        if ((oldRange.min == total.min && segments[i].min > oldRange.min) || (oldRange.max == total.max && segments[i].max < oldRange.max))
+            shrunk = true;
+
+        total.min = std::min(total.min, segments[i].min);
+        total.max = std::max(total.max, segments[i].max);
+    }
+
+    if (shrunk) refold();
+}
+
+void CurveBounds::refold() {
+    total = segments.front();
+    for (const ValueRange& segment : segments) {
+        total.min = std::min(total.min, segment.min);
+        total.max = std::max(total.max, segment.max);
+    }
+}
\ No newline at end of file
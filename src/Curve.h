@@ -0,0 +1,57 @@
+#pragma once
+
+#include "KeyFrame.h"
+
+#include <functional>
+#include <vector>
+
+struct ValueRange {
+    float min;
+    float max;
+};
+
+// how the value moves between two keyframes. step holds the left keyframe's value until the next
+// keyframe, linear ignores the slopes
+enum class Interpolation {
+    STEP,
+    LINEAR,
+    HERMITE
+};
+
+const char* GetInterpolationName(Interpolation interpolation);
+
+float HermiteInterpolate(float y_0, float y_1, float m_0, float m_1, float diff, float weight);
+
+// Evaluates the curve at count evenly spaced frames starting at startFrame, writing to out. Walks the
+// keyframes once alongside the samples, instead of searching them again for every sample. Expects the
+// keyframes to be sorted by frame. The interpolation picks a loop compiled for that mode, so step and
+// linear curves don't pay for hermite evaluation.
+void SampleCurve(const std::vector<KeyFrame>& keyframes, Interpolation interpolation, float startFrame, float frameStep, int count, float* out);
+
+// keyframes every step frames from the first to the last keyframe, with slopes taken from the curve
+std::vector<KeyFrame> ResampleCurve(const std::vector<KeyFrame>& keyframes, int step, Interpolation interpolation);
+
+// removes keyframes as long as the curve stays within tolerance of the original at every whole frame.
+// each kept keyframe is joined to the furthest one a galloping search finds, so long removable runs
+// cost O(n log n) rather than O(n^2).
+// onProgress is called now and then with the fraction done. if it returns false the simplification is
+// cancelled, and the keyframes are returned unchanged
+std::vector<KeyFrame> SimplifyCurve(const std::vector<KeyFrame>& keyframes, float tolerance, Interpolation interpolation, const std::function<bool(float)>& onProgress = nullptr);
+
+// exact min/max of the curve between two keyframes, found from the roots of the segment's derivative
+ValueRange GetSegmentRange(const KeyFrame& left, const KeyFrame& right, Interpolation interpolation);
+
+// Value range of a whole curve, cached per segment so that moving a single keyframe only has to
+// re-solve the two segments touching it.
+struct CurveBounds {
+    void rebuild(const std::vector<KeyFrame>& keyframes, Interpolation interpolation);
+    // uses the interpolation of the last rebuild
+    void update(const std::vector<KeyFrame>& keyframes, int keyframeIndex);
+
+    std::vector<ValueRange> segments;
+    ValueRange total = { 0.0f, 0.0f };
+    Interpolation interpolation = Interpolation::HERMITE;
+
+private:
+    void refold();
+};
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "CurveFile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+static bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool IsNameChar(char c) {
+    return !IsSpace(c) && c != '/' && c != '>' && c != '=' && c != '\0';
+}
+
+static bool ParseFloat(const std::string& text, size_t begin, size_t end, float& value) {
+    const char* first = text.data() + begin;
+    const char* last = text.data() + end;
+    if (first != last && *first == '+') first++;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && ptr == last;
+}
+
+struct Attribute {
+    std::string name;
+    size_t valueBegin;
+    size_t valueEnd;
+};
+
+// parses the attributes of a tag from pos up to its closing '>', which pos is left on
+static bool ParseAttributes(const std::string& text, size_t& pos, std::vector<Attribute>& attributes, std::string& error) {
+    attributes.clear();
+
+    while (pos < text.size()) {
+        while (pos < text.size() && IsSpace(text[pos])) pos++;
+        if (pos >= text.size()) break;
+
+        if (text[pos] == '>') return true;
+        if (text[pos] == '/' || text[pos] == '?') {
+            pos++;
+            continue;
+        }
+
+        size_t nameBegin = pos;
+        while (pos < text.size() && IsNameChar(text[pos])) pos++;
+        std::string name = text.substr(nameBegin, pos - nameBegin);
+
+        while (pos < text.size() && IsSpace(text[pos])) pos++;
+        if (pos >= text.size() || text[pos] != '=') {
+            error = "expected '=' after attribute '" + name + "'";
+            return false;
+        }
+        pos++;
+        while (pos < text.size() && IsSpace(text[pos])) pos++;
+
+        if (pos >= text.size() || (text[pos] != '"' && text[pos] != '\'')) {
+            error = "expected a quoted value for attribute '" + name + "'";
+            return false;
+        }
+        char quote = text[pos++];
+        size_t valueEnd = text.find(quote, pos);
+        if (valueEnd == std::string::npos) break;
+
+        attributes.push_back({ name, pos, valueEnd });
+        pos = valueEnd + 1;
+    }
+
+    error = "unterminated tag";
+    return false;
+}
+
+// isFractional is set if the frame had to be rounded
+static bool ParseKeyFrame(const std::string& text, const std::vector<Attribute>& attributes, KeyFrame& keyframe, bool& isFractional, std::string& error) {
+    bool hasFrame = false;
+    bool hasValue = false;
+    float frame = 0.0f;
+    keyframe.slope = 0.0f;
+
+    for (const Attribute& attribute : attributes) {
+        bool ok = true;
+        if (attribute.name == "Frame") {
+            ok = ParseFloat(text, attribute.valueBegin, attribute.valueEnd, frame);
+            hasFrame = true;
+        } else if (attribute.name == "Value") {
+            ok = ParseFloat(text, attribute.valueBegin, attribute.valueEnd, keyframe.value);
+            hasValue = true;
+        } else if (attribute.name == "Slope") {
+            ok = ParseFloat(text, attribute.valueBegin, attribute.valueEnd, keyframe.slope);
+        }
+
+        if (!ok) {
+            error = "invalid number in KeyFrame attribute '" + attribute.name + "'";
+            return false;
+        }
+    }
+
+    if (!hasFrame || !hasValue) {
+        error = "KeyFrame is missing its Frame or Value";
+        return false;
+    }
+
+    // the editor only works on whole frames
+    keyframe.frame = (int)std::lround(frame);
+    isFractional = keyframe.frame != frame;
+    return true;
+}
+
+// constant curves hold each value until the next keyframe, the same as step ones
+static Interpolation ParseCurveType(const std::string& text, const Attribute& attribute) {
+    size_t length = attribute.valueEnd - attribute.valueBegin;
+    if (text.compare(attribute.valueBegin, length, "Step") == 0 || text.compare(attribute.valueBegin, length, "Constant") == 0)
+        return Interpolation::STEP;
+    if (text.compare(attribute.valueBegin, length, "Linear") == 0)
+        return Interpolation::LINEAR;
+    return Interpolation::HERMITE;
+}
+
+bool ParseCurveXml(std::string text, CurveDocument& document, std::string& error) {
+    document.text = std::move(text);
+    document.tracks.clear();
+
+    const std::string& source = document.text;
+    std::string owner;
+    Interpolation ownerInterpolation = Interpolation::HERMITE;
+    std::vector<Attribute> attributes;
+    // end of the last KeyFrame element, or npos if the current run has been broken
+    size_t runEnd = std::string::npos;
+
+    size_t pos = 0;
+    while ((pos = source.find('<', pos)) != std::string::npos) {
+        size_t tagBegin = pos;
+
+        if (source.compare(pos, 4, "<!--") == 0) {
+            size_t commentEnd = source.find("-->", pos);
+            if (commentEnd == std::string::npos) {
+                error = "unterminated comment";
+                return false;
+            }
+            pos = commentEnd + 3;
+            runEnd = std::string::npos;
+            continue;
+        }
+
+        bool isClosing = pos + 1 < source.size() && source[pos + 1] == '/';
+        pos += isClosing ? 2 : 1;
+
+        size_t nameBegin = pos;
+        while (pos < source.size() && IsNameChar(source[pos])) pos++;
+        std::string name = source.substr(nameBegin, pos - nameBegin);
+
+        if (!ParseAttributes(source, pos, attributes, error)) return false;
+        pos++;
+
+        if (isClosing || name != "KeyFrame") {
+            if (!isClosing && name[0] != '?') {
+                owner = name;
+                ownerInterpolation = Interpolation::HERMITE;
+                bool hasName = false;
+                for (const Attribute& attribute : attributes) {
+                    if (!hasName && (attribute.name == "Name" || attribute.name == "Target")) {
+                        owner = source.substr(attribute.valueBegin, attribute.valueEnd - attribute.valueBegin);
+                        hasName = true;
+                    } else if (attribute.name == "CurveType") {
+                        ownerInterpolation = ParseCurveType(source, attribute);
+                    }
+                }
+            }
+            runEnd = std::string::npos;
+            continue;
+        }
+
+        KeyFrame keyframe = { 0, 0.0f, 0.0f };
+        bool isFractional = false;
+        if (!ParseKeyFrame(source, attributes, keyframe, isFractional, error)) return false;
+
+        bool continuesRun = runEnd != std::string::npos;
+        for (size_t i = runEnd; continuesRun && i < tagBegin; i++)
+            continuesRun = IsSpace(source[i]);
+
+        if (continuesRun) {
+            Track& track = document.tracks.back();
+            if (track.keyframes.size() == 1) track.separator = source.substr(runEnd, tagBegin - runEnd);
+        } else {
+            Track track;
+            track.name = owner.empty() ? "track" : owner;
+            track.interpolation = ownerInterpolation;
+            track.begin = tagBegin;
+
+            // keep the default separator lined up with the first keyframe
+            size_t lineBegin = source.rfind('\n', tagBegin);
+            lineBegin = lineBegin == std::string::npos ? 0 : lineBegin + 1;
+            if (std::all_of(source.begin() + lineBegin, source.begin() + tagBegin, IsSpace))
+                track.separator = "\n" + source.substr(lineBegin, tagBegin - lineBegin);
+
+            document.tracks.push_back(std::move(track));
+        }
+
+        Track& track = document.tracks.back();
+        track.hasUnsortedFrames |= !track.keyframes.empty() && keyframe.frame < track.keyframes.back().frame;
+        track.keyframes.push_back(keyframe);
+        track.hasFractionalFrames |= isFractional;
+        track.end = pos;
+        runEnd = pos;
+    }
+
+    return true;
+}
+
+template <typename T>
+static void AppendNumber(std::string& out, T value) {
+    char buffer[32];
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, ptr);
+}
+
+void AppendKeyFrameXml(std::string& out, const KeyFrame& keyframe) {
+    out.append("<KeyFrame Frame=\"");
+    AppendNumber(out, keyframe.frame);
+    out.append("\" Value=\"");
+    AppendNumber(out, keyframe.value);
+    out.append("\" Slope=\"");
+    AppendNumber(out, keyframe.slope);
+    out.append("\"/>");
+}
+
+void WriteCurveXml(const CurveDocument& document, std::string& out) {
+    const std::string& source = document.text;
+    out.reserve(out.size() + source.size());
+
+    size_t pos = 0;
+    for (const Track& track : document.tracks) {
+        // left in the source, and copied along with the text after it
+        if (!track.isModified) continue;
+
+        out.append(source, pos, track.begin - pos);
+
+        for (size_t i = 0; i < track.keyframes.size(); i++) {
+            if (i > 0) out.append(track.separator);
+            AppendKeyFrameXml(out, track.keyframes[i]);
+        }
+
+        pos = track.end;
+    }
+
+    out.append(source, pos, std::string::npos);
+}
\ No newline at end of file
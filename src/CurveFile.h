@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Curve.h"
+
+#include <string>
+#include <vector>
+
+// A run of consecutive <KeyFrame> elements in a document.
+struct Track {
+    std::string name;
+    std::vector<KeyFrame> keyframes;
+    // from the CurveType attribute of the element the keyframes are in, hermite if it has none
+    Interpolation interpolation = Interpolation::HERMITE;
+    // keyframes only hold whole frames, so a track with fractional ones was rounded when parsing and
+    // must not be written back
+    bool hasFractionalFrames = false;
+    // the curve functions all expect keyframes sorted by frame, which files don't guarantee
+    bool hasUnsortedFrames = false;
+    // only modified tracks are regenerated by WriteCurveXml, the others are copied from the text as they were
+    bool isModified = false;
+
+    // where the run is in the document text, so it can be replaced in place when writing
+    size_t begin = 0;
+    size_t end = 0;
+    std::string separator = "\n";
+};
+
+// An XML document in the format used by LayoutLibrary.CLI. Everything other than the keyframes is kept
+// as it is, so that re-exporting only touches the curves.
+struct CurveDocument {
+    std::string text;
+    std::vector<Track> tracks;
+};
+
+// returns false and sets error if the text is not well formed enough to find the keyframes in
+bool ParseCurveXml(std::string text, CurveDocument& document, std::string& error);
+
+// appends the document to out, with each modified track's keyframes regenerated from its current data
+void WriteCurveXml(const CurveDocument& document, std::string& out);
+
+// appends a single <KeyFrame .../> element, formatted with std::to_chars
+void AppendKeyFrameXml(std::string& out, const KeyFrame& keyframe);
\ No newline at end of file
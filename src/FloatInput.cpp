@@ -3,11 +3,7 @@
 
 #include <string>
 
-FloatInput::FloatInput(const Font& font, float value, Vector2 pos, Vector2 sizeOpt, Anchor anchor) : font(font), pos(pos), value(value) {
-    float spacing = 1.0f;
-    Vector2 textSize = MeasureTextEx(font, text.c_str(), font.baseSize, spacing);
-    size.x = sizeOpt.x == 0 ? textSize.x + 20.0f : sizeOpt.x;
-    size.y = sizeOpt.y == 0 ? textSize.y + 10.0f : sizeOpt.y;
+FloatInput::FloatInput(const Font& font, float value, Vector2 pos, Vector2 sizeOpt, Anchor anchor) : font(font), offset(pos), pos(pos), sizeOpt(sizeOpt), value(value) {
     text = format("%.1f", value);
     text.pop_back();
 
@@ -15,44 +11,67 @@ FloatInput::FloatInput(const Font& font, float value, Vector2 pos, Vector2 sizeO
     if (anchor & cAnchor_Bottom) origin.y =  1;
     if (anchor & cAnchor_Left)   origin.x = -1;
     if (anchor & cAnchor_Right)  origin.x =  1;
+
+    measure();
+}
+
+bool FloatInput::measure() {
+    Vector2 oldSize = size;
+
+    Vector2 textSize = MeasureTextLine(font, text, 1.0f);
+    size.x = sizeOpt.x == 0 ? textSize.x + padding * 2 : sizeOpt.x;
+    size.y = sizeOpt.y == 0 ? textSize.y : sizeOpt.y;
+
+    topLeft = { pos.x - (size.x / 2) * (1 + origin.x), pos.y - (size.y / 2) * (1 + origin.y) };
+
+    return size.x != oldSize.x || size.y != oldSize.y;
+}
+
+void FloatInput::setPos(const Vector2& newPos) {
+    pos = newPos;
+    measure();
 }
 
 void FloatInput::draw() const {
-    Vector2 topLeft = { pos.x - (size.x / 2) * (1 + origin.x), pos.y - (size.y / 2) * (1 + origin.y) };
     DrawRectangleRounded({ topLeft.x, topLeft.y, size.x, size.y }, 1.0f, 10, state == State::CLICKED ? GRAY : LIGHTGRAY);
 
-    topLeft.x += padding;
-    DrawTextEx(font, text.c_str(), topLeft, font.baseSize, 1.0f, BLACK);
+    DrawTextEx(font, text.c_str(), { topLeft.x + padding, topLeft.y }, font.baseSize, 1.0f, BLACK);
 }
 
-void FloatInput::update(const Vector2& mousePos) {
-    size = MeasureTextEx(font, text.c_str(), font.baseSize, 1.0f);
-    size.x += padding * 2;
+void FloatInput::focus() {
+    if (state == State::IDLE) state = State::CLICKED;
+}
 
-    Vector2 topLeft = { pos.x - (size.x / 2) * (1 + origin.x), pos.y - (size.y / 2) * (1 + origin.y) };
+bool FloatInput::unfocus() {
+    if (state != State::CLICKED) return false;
+    return saveValue();
+}
 
-    if (state == State::IDLE) {
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInRect(mousePos, topLeft, size)) state = State::CLICKED;
-    } else if (state == State::CLICKED) {
-        if (IsKeyPressed(KEY_BACKSPACE) && !text.empty()) {
-            text.pop_back();
-        }
-        
-        if (text.length() <= 6) {
-            int key = GetCharPressed();
-            while (key > 0) {
-                if (key >= KEY_ZERO && key <= KEY_NINE) text.push_back((char)key);
+bool FloatInput::update(const InputFrame& input) {
+    if (state != State::CLICKED) return false;
 
-                key = GetCharPressed();
-            }
+    bool textChanged = false;
 
-            if (IsKeyPressed(KEY_PERIOD) && text.find('.') == std::string::npos) {
-                text.push_back('.');
+    if (input.isKeyPressed(KEY_BACKSPACE) && !text.empty()) {
+        text.pop_back();
+        textChanged = true;
+    }
+
+    if (text.length() <= 6) {
+        for (char key : input.chars) {
+            if ((key >= KEY_ZERO && key <= KEY_NINE) || (key == '-' && allowNegative && text.empty())) {
+                text.push_back(key);
+                textChanged = true;
             }
         }
 
-
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && !IsPointInRect(mousePos, topLeft, size)) saveValue();
-        else if (IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) saveValue();
+        if (input.isKeyPressed(KEY_PERIOD) && text.find('.') == std::string::npos) {
+            text.push_back('.');
+            textChanged = true;
+        }
     }
-}
+
+    if (input.isKeyPressed(KEY_ENTER) || input.isMouseButtonPressed(MOUSE_BUTTON_RIGHT)) return saveValue();
+
+    return textChanged && measure();
+}
\ No newline at end of file
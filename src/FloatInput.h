@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Input.h"
 #include "utils.h"
 
 #include <stdexcept>
@@ -26,10 +27,23 @@ struct FloatInput {
         cAnchor_BottomRight = cAnchor_Bottom | cAnchor_Right,
     };
 
-    FloatInput(const Font& font, float value, Vector2 pos, Vector2 size, Anchor anchor = cAnchor_Center);
+    FloatInput(const Font& font, float value, Vector2 pos, Vector2 sizeOpt, Anchor anchor = cAnchor_Center);
 
     void draw() const;
-    void update(const Vector2& mousePos);
+
+    // handles keyboard input while focused. returns true if the size of the input changed
+    bool update(const InputFrame& input);
+
+    // called by Layout when the mouse is pressed over this input / anywhere else while it is focused.
+    // unfocus returns true if the size of the input changed
+    void focus();
+    bool unfocus();
+
+    void setPos(const Vector2& newPos);
+
+    Rectangle getRect() const {
+        return { topLeft.x, topLeft.y, size.x, size.y };
+    }
 
     void disable() {
         state = State::DISABLED;
@@ -41,32 +55,40 @@ struct FloatInput {
 
     State state = State::IDLE;
     const Font& font;
+    LayoutAnchor layoutAnchor = LayoutAnchor::SCREEN;
+    Vector2 offset = { 0, 0 };
     Vector2 pos = { 0, 0 };
     Vector2 size = { 0, 0 };
+    Vector2 sizeOpt = { 0, 0 };
     Vector2 origin = { 0, 0 };
+    Vector2 topLeft = { 0, 0 };
     std::string text;
     float value = 0.0f;
     float padding = 5.0f;
+    bool allowNegative = false;
+    // digits kept after the decimal point when a typed value is saved
+    int decimals = 1;
+    // text that isn't a number keeps the previous value, instead of resetting to the y range default
+    bool keepValueOnInvalid = false;
 
 private:
-    void saveValue() {
-        if (state == State::DISABLED) return;
+    // recomputes the size and top left corner, only needed when the text or position changes
+    bool measure();
+
+    bool saveValue() {
+        if (state == State::DISABLED) return false;
 
         state = State::IDLE;
 
-        float tmp;
+        float tmp = keepValueOnInvalid ? value : 2.0f;
         try {
             tmp = std::stof(text);
-        } catch (std::invalid_argument) {
-            tmp = 2.0f;
+        } catch (const std::logic_error&) {
+            // not a number, or too big for a float
         }
-        text = format("%.1f", tmp);
+        text = format("%.*f", decimals, tmp);
         text.pop_back();
         value = std::stof(text);
-    }
-
-    bool isClicked(const Vector2& mousePos) const {
-        Vector2 topLeft = { pos.x - (size.x / 2) * (1 + origin.x), pos.y - (size.y / 2) * (1 + origin.y) };
-        return IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInRect(mousePos, topLeft, size);
+        return measure();
     }
 };
\ No newline at end of file
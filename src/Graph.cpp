@@ -1,40 +1,12 @@
 #include "Graph.h"
+#include "Curve.h"
 #include "KeyFrame.h"
 #include "utils.h"
 
-#include "raymath.h"
-
-float HermiteInterpolate(float y_0, float y_1, float m_0, float m_1, float diff, float weight) {
-    float result;
-
-    result = y_0 + (y_0 - y_1) * (2 * weight - 3) * weight * weight;
-    result += (diff * (weight - 1)) * (m_0 * (weight - 1) + m_1 * weight);
-
-    return result;
-}
-
-// credit to https://github.com/gdkchan/SPICA/blob/42c4181e198b0fd34f0a567345ee7e75b54cb58b/SPICA/Formats/CtrH3D/Animation/H3DFloatKeyFrameGroup.cs
-float GetInterpolatedValue(const std::vector<KeyFrame>& keyframes, float frame) {
-    if (keyframes.size() == 0) return 0;
-    if (keyframes.size() == 1) return keyframes[0].value;
+#include <algorithm>
+#include <cmath>
 
-    const KeyFrame* leftKeyframe = &keyframes.front();
-    const KeyFrame* rightKeyframe = &keyframes.back();
-
-    for (const KeyFrame& keyframe : keyframes) {
-        if (keyframe.frame <= frame)
-            leftKeyframe = &keyframe;
-        if (keyframe.frame >= frame && keyframe.frame < rightKeyframe->frame)
-            rightKeyframe = &keyframe;
-    }
-
-    if (leftKeyframe->frame == rightKeyframe->frame) return leftKeyframe->value;
-
-    float frameDiff = frame - leftKeyframe->frame;
-    float weight = frameDiff / (rightKeyframe->frame - leftKeyframe->frame);
-
-    return HermiteInterpolate(leftKeyframe->value, rightKeyframe->value, leftKeyframe->slope, rightKeyframe->slope, frameDiff, weight);
-}
+#include "raymath.h"
 
 Graph::Graph(const Font& font, int screenWidth, int screenHeight) :
     font(font),
@@ -46,25 +18,40 @@ Graph::Graph(const Font& font, int screenWidth, int screenHeight) :
     keyframes.push_back({ 15, 0.50f,  0.00f });
     keyframes.push_back({ 26, 0.53f,  0.03f });
     keyframes.push_back({ 30, 1.00f,  0.44f });
+    updateBounds();
 
     yRangeInput = new FloatInput(
         font,
         yRange,
-        { left - 15, bottom - yTickCount * yTickHeight },
+        { -15, 0 },
         { 0, 0 },
         FloatInput::cAnchor_Right
     );
+    yRangeInput->layoutAnchor = LayoutAnchor::GRAPH_TOP_LEFT;
+
+    bulkAmountInput = new FloatInput(
+        font,
+        1.0f,
+        { 0, 60 },
+        { 0, 0 },
+        FloatInput::cAnchor_TopRight
+    );
+    bulkAmountInput->layoutAnchor = LayoutAnchor::GRAPH_BOTTOM_RIGHT;
+    bulkAmountInput->allowNegative = true;
+    // scale factors like 0.25 need more than one decimal, and a typo shouldn't scale everything by 2
+    bulkAmountInput->decimals = 3;
+    bulkAmountInput->keepValueOnInvalid = true;
 }
 
 const Vector2 Graph::coordToScreenPos(const Vector2& coord) const {
     float xPos = left + coord.x * frameWidth;
-    float yPos = bottom - coord.y * height / yRange;
+    float yPos = bottom - (coord.y - yMin) * height / yRange;
     return { xPos, yPos };
 }
 
 const Vector2 Graph::screenPosToCoord(const Vector2& screenPos) const {
     float xCoord = (screenPos.x - left) / frameWidth;
-    float yCoord = (bottom - screenPos.y) / height * yRange;
+    float yCoord = (bottom - screenPos.y) / height * yRange + yMin;
     return { xCoord, yCoord };
 }
 
@@ -78,6 +65,249 @@ void Graph::resize(int screenWidth, int screenHeight) {
     frameWidth = width / frameCount;
 }
 
+void Graph::updateBounds() {
+    bounds.rebuild(keyframes, interpolation);
+    revision++;
+}
+
+void Graph::updateBounds(const KeyFrame& keyframe) {
+    bounds.update(keyframes, &keyframe - keyframes.data());
+    revision++;
+}
+
+void Graph::setKeyframes(std::vector<KeyFrame> newKeyframes) {
+    keyframes = std::move(newKeyframes);
+    clearSelection();
+    draggingKeyframe = nullptr;
+    selectedKeyframeControl = KeyFrame::Control::NONE;
+    isClickingNewKeyframe = false;
+
+    if (!keyframes.empty() && keyframes.back().frame > frameCount) {
+        frameCount = keyframes.back().frame;
+        frameWidth = width / frameCount;
+    }
+
+    updateBounds();
+}
+
+void Graph::setFrameCount(int count) {
+    frameCount = count;
+    frameWidth = width / frameCount;
+
+    // keyframes past the end aren't drawn, so they can't stay selected either
+    for (KeyFrame& keyframe : keyframes) {
+        bool isOffscreen = keyframe.frame > frameCount;
+        selectionCount -= keyframe.isSelected && isOffscreen;
+        keyframe.isSelected = keyframe.isSelected && !isOffscreen;
+    }
+    if (selectedKeyframe != nullptr && !selectedKeyframe->isSelected)
+        selectedKeyframe = nullptr;
+}
+
+void Graph::clearSelection() {
+    for (KeyFrame& keyframe : keyframes)
+        keyframe.isSelected = false;
+    selectedKeyframe = nullptr;
+    selectionCount = 0;
+}
+
+void Graph::selectOnly(KeyFrame& keyframe) {
+    clearSelection();
+    keyframe.isSelected = true;
+    selectedKeyframe = &keyframe;
+    selectionCount = 1;
+}
+
+void Graph::selectRange(const KeyFrame& from, const KeyFrame& to) {
+    int fromIndex = &from - keyframes.data();
+    int toIndex = &to - keyframes.data();
+    if (fromIndex > toIndex) std::swap(fromIndex, toIndex);
+
+    for (int i = fromIndex; i <= toIndex; i++) {
+        selectionCount += !keyframes[i].isSelected;
+        keyframes[i].isSelected = true;
+    }
+}
+
+void Graph::selectInRect(const Vector2& cornerA, const Vector2& cornerB, bool isAdding) {
+    if (!isAdding) clearSelection();
+
+    Vector2 coordA = screenPosToCoord(cornerA);
+    Vector2 coordB = screenPosToCoord(cornerB);
+    float minFrame = std::min(coordA.x, coordB.x);
+    float maxFrame = std::max(coordA.x, coordB.x);
+    float minValue = std::min(coordA.y, coordB.y);
+    float maxValue = std::max(coordA.y, coordB.y);
+
+    for (KeyFrame& keyframe : keyframes) {
+        bool isInside = keyframe.frame >= minFrame && keyframe.frame <= maxFrame && keyframe.frame <= frameCount &&
+            keyframe.value >= minValue && keyframe.value <= maxValue;
+        selectionCount += isInside && !keyframe.isSelected;
+        keyframe.isSelected |= isInside;
+
+        if (selectedKeyframe == nullptr && keyframe.isSelected)
+            selectedKeyframe = &keyframe;
+    }
+}
+
+void Graph::deleteSelected() {
+    if (selectionCount == 0) return;
+
+    keyframes.erase(std::remove_if(keyframes.begin(), keyframes.end(), [](const KeyFrame& keyframe){ return keyframe.isSelected; }), keyframes.end());
+    selectedKeyframe = nullptr;
+    draggingKeyframe = nullptr;
+    selectionCount = 0;
+    updateBounds();
+}
+
+const KeyFrame* Graph::getPivotKeyframe() const {
+    if (selectedKeyframe != nullptr) return selectedKeyframe;
+
+    for (const KeyFrame& keyframe : keyframes) {
+        if (keyframe.isSelected) return &keyframe;
+    }
+    return nullptr;
+}
+
+// The loops below run over every keyframe and pick between the old and new values instead of branching,
+// so a scattered selection doesn't cost a misprediction per keyframe. Most of a transform's time goes to
+// rebuilding the bounds and merging afterwards, `--bench-bulk` times them.
+
+// rounds half away from zero like std::lround, without a libm call for every keyframe
+static int RoundToFrame(float frame) {
+    return (int)(frame + (frame < 0.0f ? -0.5f : 0.5f));
+}
+
+void Graph::offsetSelectedFrames(int offset) {
+    if (selectionCount == 0 || offset == 0) return;
+
+    for (KeyFrame& keyframe : keyframes)
+        keyframe.frame += keyframe.isSelected ? offset : 0;
+
+    mergeSelection(false);
+}
+
+void Graph::scaleSelectedFrames(float scale, float pivotFrame) {
+    if (selectionCount == 0 || scale == 0.0f) return;
+
+    // the slopes are per frame, so they have to be scaled the other way to keep the curve's shape
+    float slopeScale = 1.0f / scale;
+    for (KeyFrame& keyframe : keyframes) {
+        int scaledFrame = RoundToFrame(pivotFrame + (keyframe.frame - pivotFrame) * scale);
+        keyframe.frame = keyframe.isSelected ? scaledFrame : keyframe.frame;
+        keyframe.slope = keyframe.isSelected ? keyframe.slope * slopeScale : keyframe.slope;
+    }
+
+    mergeSelection(scale < 0.0f);
+}
+
+void Graph::offsetSelectedValues(float offset) {
+    if (selectionCount == 0) return;
+
+    for (KeyFrame& keyframe : keyframes)
+        keyframe.value += keyframe.isSelected ? offset : 0.0f;
+
+    updateBounds();
+}
+
+void Graph::scaleSelectedValues(float scale, float pivotValue) {
+    if (selectionCount == 0) return;
+
+    for (KeyFrame& keyframe : keyframes) {
+        keyframe.value = keyframe.isSelected ? pivotValue + (keyframe.value - pivotValue) * scale : keyframe.value;
+        keyframe.slope = keyframe.isSelected ? keyframe.slope * scale : keyframe.slope;
+    }
+
+    updateBounds();
+}
+
+void Graph::scaleSelectedSlopes(float scale) {
+    if (selectionCount == 0) return;
+
+    for (KeyFrame& keyframe : keyframes)
+        keyframe.slope = keyframe.isSelected ? keyframe.slope * scale : keyframe.slope;
+
+    updateBounds();
+}
+
+void Graph::mergeSelection(bool isReversed) {
+    int selectedFrame = selectedKeyframe != nullptr ? selectedKeyframe->frame : 0;
+    bool hadSelectedKeyframe = selectedKeyframe != nullptr;
+
+    // a time transform keeps the selected keyframes in order among themselves (reversed, for a negative
+    // scale), and the unselected ones weren't moved, so the two runs only need merging
+    selectedScratch.clear();
+    unselectedScratch.clear();
+    for (const KeyFrame& keyframe : keyframes)
+        (keyframe.isSelected ? selectedScratch : unselectedScratch).push_back(keyframe);
+
+    if (isReversed) std::reverse(selectedScratch.begin(), selectedScratch.end());
+
+    // where keyframes land on the same frame, the first selected one wins and the others are dropped
+    keyframes.clear();
+    size_t selectedIndex = 0;
+    size_t unselectedIndex = 0;
+    while (selectedIndex < selectedScratch.size() || unselectedIndex < unselectedScratch.size()) {
+        bool takeSelected = unselectedIndex == unselectedScratch.size() ||
+            (selectedIndex < selectedScratch.size() && selectedScratch[selectedIndex].frame <= unselectedScratch[unselectedIndex].frame);
+        const KeyFrame& next = takeSelected ? selectedScratch[selectedIndex++] : unselectedScratch[unselectedIndex++];
+
+        if (!keyframes.empty() && keyframes.back().isSelected && keyframes.back().frame == next.frame) continue;
+        keyframes.push_back(next);
+    }
+
+    selectedKeyframe = nullptr;
+    draggingKeyframe = nullptr;
+    selectionCount = 0;
+    for (KeyFrame& keyframe : keyframes) {
+        // keyframes moved past the end can't be seen, so they leave the selection
+        keyframe.isSelected = keyframe.isSelected && keyframe.frame <= frameCount;
+        selectionCount += keyframe.isSelected;
+        if (hadSelectedKeyframe && selectedKeyframe == nullptr && keyframe.isSelected && keyframe.frame == selectedFrame)
+            selectedKeyframe = &keyframe;
+    }
+
+    updateBounds();
+}
+
+void Graph::setAutoFit(bool enabled) {
+    autoFit = enabled;
+    if (autoFit) {
+        yRangeInput->disable();
+    } else {
+        yRangeInput->enable();
+        yMin = 0.0f;
+        yRange = yRangeInput->value;
+    }
+}
+
+void Graph::setInterpolation(Interpolation newInterpolation) {
+    interpolation = newInterpolation;
+    // step and linear segments can't overshoot, so the bounds depend on the mode
+    updateBounds();
+    if (onInterpolationChanged) onInterpolationChanged();
+}
+
+void Graph::fitValueRange() {
+    ValueRange range = bounds.total;
+    float extent = range.max - range.min;
+    if (extent < 0.01f) extent = 1.0f;
+
+    float padding = extent * 0.1f;
+    yMin = range.min - padding;
+    yRange = extent + padding * 2;
+}
+
+void Graph::growValueRange(float value) {
+    float yMax = yMin + yRange;
+    yMin = std::min(yMin, value);
+    yRange = std::max(yMax, value) - yMin;
+}
+
+bool Graph::isOvershooting() const {
+    return isAlphaTrack && !keyframes.empty() && (bounds.total.min < 0.0f || bounds.total.max > 1.0f);
+}
+
 void Graph::draw() const {
     // draw timeline (x-axis)
     DrawLineEx({ left, bottom }, { right, bottom }, 3, BLACK);
@@ -104,28 +334,37 @@ void Graph::draw() const {
         DrawTextCenter(font, format("%d", i), { tickPosX, bottom + 25 }, BLACK);
     }
 
-    // draw text box for y-axis range
-    yRangeInput->draw();
-
     // draw ticks next to y-axis
     for (int i = 0; i <= yTickCount; i++) {
         float linePosY = bottom - i * yTickHeight;
         DrawLineEx({ left, linePosY }, { left - 10, linePosY }, 2, GRAY);
         if (i == yTickCount) break;
-        float tickValue = yRange * i / yTickCount;
-        DrawTextRightAlign(font, format("%.1f", tickValue), { left - 20, linePosY }, BLACK);
+        float tickValue = yMin + yRange * i / yTickCount;
+        DrawTextRightAlign(font, format(yRange / yTickCount < 0.1f ? "%.2f" : "%.1f", tickValue), { left - 20, linePosY }, BLACK);
     }
 
-    // draw hermite interpolation
+    // draw interpolated curve
     if (keyframes.empty()) return;
     const float step = 1.0f;
-    for (float xPos = left + step; xPos < right + step / 2 && xPos < keyframes.back().getScreenPos(*this).x; xPos += step) {
-        float interpFrame = screenPosToCoord({ xPos, 0.0f }).x;
-        float interpValue = GetInterpolatedValue(keyframes, interpFrame);
-        
+    float endPosX = std::min(right + step / 2, keyframes.back().getScreenPos(*this).x);
+    int sampleCount = std::max(0, (int)std::ceil((endPosX - left) / step) - 1);
+    std::vector<float> samples(sampleCount);
+    SampleCurve(keyframes, interpolation, screenPosToCoord({ left + step, 0.0f }).x, step / frameWidth, sampleCount, samples.data());
+
+    for (int i = 0; i < sampleCount; i++) {
+        float xPos = left + (i + 1) * step;
+        float interpValue = samples[i];
+
         float yPos = coordToScreenPos({ 0.0f, interpValue }).y;
 
-        DrawCircleV({ xPos, yPos }, 2.0f, ColorAlpha(GREEN, 0.5f));
+        bool isOutOfRange = isAlphaTrack && (interpValue < 0.0f || interpValue > 1.0f);
+        DrawCircleV({ xPos, yPos }, 2.0f, ColorAlpha(isOutOfRange ? RED : GREEN, 0.5f));
+    }
+
+    // warn about alpha values that can't be represented
+    if (isOvershooting()) {
+        std::string warning = format("Alpha curve leaves 0..1 (min %.3f, max %.3f)", bounds.total.min, bounds.total.max);
+        DrawTextCenter(font, warning, { left + width / 2, top - 15.0f }, RED);
     }
 
     drawKeyframes();
@@ -137,9 +376,20 @@ void Graph::drawKeyframes() const {
         DrawCircleV(ghostKeyframePos, KeyFrame::RADIUS, ColorAlpha(RED, 0.5f));
     }
 
-    // draw keyframe points
+    // draw keyframe points, slopes only do anything on hermite curves
+    bool hasSlopes = interpolation == Interpolation::HERMITE;
     for (const KeyFrame& keyframe : keyframes) {
-        keyframe.draw(*this, selectedKeyframe == &keyframe);
+        keyframe.draw(*this, hasSlopes && selectedKeyframe == &keyframe);
+    }
+
+    // draw marquee selection
+    if (isMarqueeSelecting) {
+        Rectangle marquee = {
+            std::min(marqueeStart.x, marqueeEnd.x), std::min(marqueeStart.y, marqueeEnd.y),
+            std::abs(marqueeEnd.x - marqueeStart.x), std::abs(marqueeEnd.y - marqueeStart.y)
+        };
+        DrawRectangleRec(marquee, ColorAlpha(BLUE, 0.2f));
+        DrawRectangleLinesEx(marquee, 1.0f, BLUE);
     }
 
     // draw selected keyframe's data
@@ -151,6 +401,7 @@ void Graph::drawKeyframes() const {
         float rounding;
         if (selectedKeyframe != nullptr) {
             text = format("Selected keyframe:\nFrame: %d\nValue: %.03f\nSlope: %.03f", selectedKeyframe->frame, selectedKeyframe->value, selectedKeyframe->slope);
+            if (selectionCount > 1) text += format("\n(%d selected)", selectionCount);
             rounding = 0.3f;
         } else {
             text = "Selected keyframe:";
@@ -163,15 +414,33 @@ void Graph::drawKeyframes() const {
     } 
 }
 
-void Graph::update(const Vector2& mousePos) {
-    yRangeInput->update(mousePos);
-    yRange = yRangeInput->value;
+void Graph::update(const InputFrame& input) {
+    const Vector2& mousePos = input.mousePos;
+
+    // drags map the mouse through the current range, so refitting with padding every frame would feed
+    // back into itself and run away. while dragging the range only grows to fit the dragged keyframe
+    bool isDragging = draggingKeyframe != nullptr || selectedKeyframeControl != KeyFrame::Control::NONE;
+    if (autoFit && !isDragging)
+        fitValueRange();
+    else if (!autoFit)
+        yRange = yRangeInput->value;
+
+    bool isShiftDown = input.isKeyDown(KEY_LEFT_SHIFT) || input.isKeyDown(KEY_RIGHT_SHIFT);
+    bool isCtrlDown = input.isKeyDown(KEY_LEFT_CONTROL) || input.isKeyDown(KEY_RIGHT_CONTROL);
 
     // update which keyframe is selected
+    bool isKeyframeClicked = false;
     if (!isClickingNewKeyframe) {
         for (KeyFrame& keyframe : keyframes) {
-            if (keyframe.isClicked(*this, mousePos)) {
+            if (keyframe.isClicked(*this, input)) {
+                // shift extends the selection from the previously selected keyframe
+                if (isShiftDown && selectedKeyframe != nullptr)
+                    selectRange(*selectedKeyframe, keyframe);
+                else if (!keyframe.isSelected)
+                    selectOnly(keyframe);
+
                 selectedKeyframe = &keyframe;
+                isKeyframeClicked = true;
                 draggingKeyframe = nullptr;
                 selectedKeyframeControl = KeyFrame::Control::NONE;
                 keyframePixelsMoved = 0.0f;
@@ -180,16 +449,26 @@ void Graph::update(const Vector2& mousePos) {
         }
     }
 
-    // deselect keyframe if it goes off screen
-    if (selectedKeyframe != nullptr && selectedKeyframe->frame > frameCount) {
-        selectedKeyframe = nullptr;
+    // ctrl + drag selects every keyframe inside a rectangle, shift adds them to the current selection
+    if (!isKeyframeClicked && !isClickingNewKeyframe && isCtrlDown && input.isMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInRect(mousePos, topLeft, size)) {
+        isMarqueeSelecting = true;
+        marqueeStart = mousePos;
+    }
+    if (isMarqueeSelecting) {
+        marqueeEnd = mousePos;
+
+        if (input.isMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
+            selectInRect(marqueeStart, marqueeEnd, isShiftDown);
+            isMarqueeSelecting = false;
+        }
+        return;
     }
 
     // control selected keyframe
     if (selectedKeyframe != nullptr) {
         // update which control is being moved
 
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInRect(mousePos, topLeft, size)) {
+        if (input.isMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInRect(mousePos, topLeft, size)) {
             draggingKeyframe = selectedKeyframe;
             keyframePixelsMoved = 0.0f;
         }
@@ -198,12 +477,13 @@ void Graph::update(const Vector2& mousePos) {
         Vector2 leftControlPos = selectedKeyframe->getSlopeControlPos(*this, KeyFrame::Control::LEFT);
         Vector2 rightControlPos = selectedKeyframe->getSlopeControlPos(*this, KeyFrame::Control::RIGHT);
 
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInCircle(mousePos, leftControlPos, KeyFrame::RADIUS * 2)) {
+        bool hasSlopes = interpolation == Interpolation::HERMITE;
+        if (hasSlopes && input.isMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInCircle(mousePos, leftControlPos, KeyFrame::RADIUS * 2)) {
             selectedKeyframeControl = KeyFrame::Control::LEFT;
             draggingKeyframe = nullptr;
             keyframePixelsMoved = 0.0f;
         }
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInCircle(mousePos, rightControlPos, KeyFrame::RADIUS * 2)) {
+        if (hasSlopes && input.isMouseButtonPressed(MOUSE_BUTTON_LEFT) && IsPointInCircle(mousePos, rightControlPos, KeyFrame::RADIUS * 2)) {
             selectedKeyframeControl = KeyFrame::Control::RIGHT;
             draggingKeyframe = nullptr;
             keyframePixelsMoved = 0.0f;
@@ -216,12 +496,27 @@ void Graph::update(const Vector2& mousePos) {
                 keyframePixelsMoved = abs(draggingKeyframe->getScreenPos(*this).y - mousePos.y);
 
             if (keyframePixelsMoved >= 10) {
-                if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
-                    int tickIdx = (mousePos.y - top) / height * yTickCount + 0.5f;
-                    draggingKeyframe->value = screenPosToCoord({ 0, top + tickIdx * yTickHeight }).y;
+                // clamped to the graph, so the value never leaves the range it is mapped through
+                Vector2 dragPos = { std::clamp(mousePos.x, left, right), std::clamp(mousePos.y, top, bottom) };
+
+                float newValue;
+                if (isShiftDown) {
+                    int tickIdx = (dragPos.y - top) / height * yTickCount + 0.5f;
+                    newValue = screenPosToCoord({ 0, top + tickIdx * yTickHeight }).y;
                 } else {
-                    draggingKeyframe->value = screenPosToCoord(mousePos).y;
+                    newValue = screenPosToCoord(dragPos).y;
                 }
+
+                // the rest of the selection moves along with the dragged keyframe
+                if (selectionCount > 1) {
+                    offsetSelectedValues(newValue - draggingKeyframe->value);
+                } else {
+                    draggingKeyframe->value = newValue;
+                    updateBounds(*draggingKeyframe);
+                }
+
+                if (autoFit)
+                    growValueRange(draggingKeyframe->value);
             }
         }
 
@@ -232,14 +527,15 @@ void Graph::update(const Vector2& mousePos) {
             float rise = -(slopeDir.y / height * yRange);
             float slope = rise / run;
 
-            if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+            if (input.isKeyDown(KEY_LEFT_SHIFT) || input.isKeyDown(KEY_RIGHT_SHIFT)) {
                 slope = (float)((int)(slope * 10 + 0.5f) / 10.0f);
             }
 
             selectedKeyframe->slope = slope;
+            updateBounds(*selectedKeyframe);
         }
     }
-    if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
+    if (input.isMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
         selectedKeyframeControl = KeyFrame::Control::NONE;
         draggingKeyframe = nullptr;
         keyframePixelsMoved = 0.0f;
@@ -250,14 +546,14 @@ void Graph::update(const Vector2& mousePos) {
         int ghostKeyframeFrame = (mousePos.x - left) / width * frameCount + 0.5f;
         ghostKeyframePos.x = left + ghostKeyframeFrame * frameWidth;
 
-        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+        if (input.isKeyDown(KEY_LEFT_SHIFT) || input.isKeyDown(KEY_RIGHT_SHIFT)) {
             int ghostKeyframeTick = (mousePos.y - top) / height * yTickCount + 0.5f;
             ghostKeyframePos.y = top + ghostKeyframeTick * yTickHeight;
         } else {
             ghostKeyframePos.y = mousePos.y;
         }
 
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        if (input.isMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
             float ghostKeyframeValue = screenPosToCoord(ghostKeyframePos).y;
             KeyFrame newKeyframe = { ghostKeyframeFrame, ghostKeyframeValue, 0.0f };
 
@@ -284,14 +580,15 @@ void Graph::update(const Vector2& mousePos) {
 
             if (newKeyframeIndex != -1) {
                 keyframes.insert(keyframes.begin() + newKeyframeIndex, newKeyframe);
-                selectedKeyframe = &keyframes[newKeyframeIndex];
+                selectOnly(keyframes[newKeyframeIndex]);
                 isClickingNewKeyframe = false;
+                updateBounds();
             }
         }
     }
 
-    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
+    if (input.isMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
         isClickingNewKeyframe = false;
-        selectedKeyframe = nullptr;
+        clearSelection();
     }
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Curve.h"
 #include "FloatInput.h"
+#include "Input.h"
 #include "KeyFrame.h"
 
+#include <functional>
 #include <vector>
 
 #include "raylib.h"
@@ -17,7 +20,41 @@ struct Graph {
     void resize(int screenWidth, int screenHeight);
     void draw() const;
     void drawKeyframes() const;
-    void update(const Vector2& mousePos);
+    void update(const InputFrame& input);
+
+    // must be called after keyframes are added, removed or reordered
+    void updateBounds();
+    // cheaper version for when a single keyframe's value or slope changed
+    void updateBounds(const KeyFrame& keyframe);
+
+    // replaces the whole curve, e.g. with the result of a background job
+    void setKeyframes(std::vector<KeyFrame> newKeyframes);
+
+    // also drops keyframes past the new end from the selection
+    void setFrameCount(int count);
+
+    void clearSelection();
+    void selectOnly(KeyFrame& keyframe);
+    void selectRange(const KeyFrame& from, const KeyFrame& to);
+    void selectInRect(const Vector2& cornerA, const Vector2& cornerB, bool isAdding);
+    void deleteSelected();
+
+    // the keyframe that bulk transforms scale around
+    const KeyFrame* getPivotKeyframe() const;
+
+    // bulk transforms, applied to every selected keyframe at once
+    void offsetSelectedFrames(int offset);
+    void scaleSelectedFrames(float scale, float pivotFrame);
+    void offsetSelectedValues(float offset);
+    void scaleSelectedValues(float scale, float pivotValue);
+    void scaleSelectedSlopes(float scale);
+
+    void setAutoFit(bool enabled);
+    void setInterpolation(Interpolation newInterpolation);
+    void fitValueRange();
+    // widens the value range just enough to show the value, never shrinks it
+    void growValueRange(float value);
+    bool isOvershooting() const;
 
     const Font& font;
 
@@ -25,7 +62,13 @@ struct Graph {
     const float left = 100.0f;
     float bottom;
     float right;
+    float yMin = 0.0f;
     float yRange = 2.0f;
+    bool autoFit = false;
+    bool isAlphaTrack = false;
+    Interpolation interpolation = Interpolation::HERMITE;
+    // called by setInterpolation, so controls showing the mode can follow changes that didn't come from them
+    std::function<void()> onInterpolationChanged;
 
     float width = right - left;
     float height = bottom - top;
@@ -40,13 +83,32 @@ struct Graph {
     float frameWidth = width / frameCount;
 
     std::vector<KeyFrame> keyframes;
+    CurveBounds bounds;
+    // incremented on every edit, so background jobs can tell if their input is out of date
+    int revision = 0;
+    // the selected keyframe whose data and slope controls are shown, out of all the ones with isSelected set
     KeyFrame* selectedKeyframe = nullptr;
+    int selectionCount = 0;
     KeyFrame* draggingKeyframe = nullptr;
     float keyframePixelsMoved = 0.0f;
     KeyFrame::Control selectedKeyframeControl = KeyFrame::Control::NONE;
 
+    bool isMarqueeSelecting = false;
+    Vector2 marqueeStart;
+    Vector2 marqueeEnd;
+
     Vector2 ghostKeyframePos;
     bool isClickingNewKeyframe = false;
 
     FloatInput* yRangeInput = nullptr;
+    // amount used by the bulk transform buttons
+    FloatInput* bulkAmountInput = nullptr;
+
+private:
+    // puts the keyframes back in order by frame after the selected ones were moved in time
+    void mergeSelection(bool isReversed);
+
+    // reused by mergeSelection so that moving a big selection doesn't allocate every time
+    std::vector<KeyFrame> selectedScratch;
+    std::vector<KeyFrame> unselectedScratch;
 };
\ No newline at end of file
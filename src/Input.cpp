@@ -0,0 +1,203 @@
+#include "Input.h"
+
+#include <algorithm>
+
+#include "raylib.h"
+
+// flags that only exist in the file, above the ones stored in InputFrame
+static constexpr uint16_t cFileFlag_PublishedJobs = 1 << 12;
+static constexpr uint16_t cFileFlag_DroppedFiles  = 1 << 13;
+static constexpr uint16_t cFileFlag_MouseMoved    = 1 << 14;
+static constexpr uint16_t cFileFlag_Chars         = 1 << 15;
+static constexpr uint16_t cFileFlags = cFileFlag_PublishedJobs | cFileFlag_DroppedFiles | cFileFlag_MouseMoved | cFileFlag_Chars;
+
+static constexpr char cMagic[4] = { 'H', 'R', 'I', 'N' };
+static constexpr uint8_t cVersion = 4;
+
+bool InputFrame::isMouseButtonPressed(int button) const {
+    if (button == MOUSE_BUTTON_LEFT)  return flags & cFlag_LeftPressed;
+    if (button == MOUSE_BUTTON_RIGHT) return flags & cFlag_RightPressed;
+    return false;
+}
+
+bool InputFrame::isMouseButtonReleased(int button) const {
+    if (button == MOUSE_BUTTON_LEFT) return flags & cFlag_LeftReleased;
+    return false;
+}
+
+bool InputFrame::isKeyDown(int key) const {
+    if (key == KEY_LEFT_SHIFT || key == KEY_RIGHT_SHIFT)     return flags & cFlag_ShiftDown;
+    if (key == KEY_LEFT_CONTROL || key == KEY_RIGHT_CONTROL) return flags & cFlag_CtrlDown;
+    return false;
+}
+
+bool InputFrame::isKeyPressed(int key) const {
+    if (key == KEY_BACKSPACE) return flags & cFlag_BackspacePressed;
+    if (key == KEY_ENTER)     return flags & cFlag_EnterPressed;
+    if (key == KEY_PERIOD)    return flags & cFlag_PeriodPressed;
+    return false;
+}
+
+InputFrame PollInput() {
+    InputFrame frame;
+
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))       frame.flags |= InputFrame::cFlag_LeftPressed;
+    if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT))      frame.flags |= InputFrame::cFlag_LeftReleased;
+    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT))      frame.flags |= InputFrame::cFlag_RightPressed;
+    if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) frame.flags |= InputFrame::cFlag_ShiftDown;
+    if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) frame.flags |= InputFrame::cFlag_CtrlDown;
+    if (IsKeyPressed(KEY_BACKSPACE))                   frame.flags |= InputFrame::cFlag_BackspacePressed;
+    if (IsKeyPressed(KEY_ENTER))                       frame.flags |= InputFrame::cFlag_EnterPressed;
+    if (IsKeyPressed(KEY_PERIOD))                      frame.flags |= InputFrame::cFlag_PeriodPressed;
+    if (IsWindowResized())                             frame.flags |= InputFrame::cFlag_Resized;
+
+    frame.mousePos = GetMousePosition();
+    frame.screenWidth = GetScreenWidth();
+    frame.screenHeight = GetScreenHeight();
+
+    int key = GetCharPressed();
+    while (key > 0) {
+        if (key < 0x80) frame.chars.push_back((char)key);
+        key = GetCharPressed();
+    }
+
+    if (IsFileDropped()) {
+        FilePathList droppedFiles = LoadDroppedFiles();
+        for (unsigned int i = 0; i < droppedFiles.count; i++)
+            frame.droppedFiles.push_back(droppedFiles.paths[i]);
+        UnloadDroppedFiles(droppedFiles);
+    }
+
+    return frame;
+}
+
+template <typename T>
+static void WriteValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool ReadValue(std::ifstream& file, T& value) {
+    return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+bool InputRecorder::open(const char* path, int screenWidth, int screenHeight, int keyCount) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    file.write(cMagic, sizeof(cMagic));
+    WriteValue(file, cVersion);
+    WriteValue(file, (int16_t)screenWidth);
+    WriteValue(file, (int16_t)screenHeight);
+    WriteValue(file, (int32_t)keyCount);
+    return (bool)file;
+}
+
+void InputRecorder::write(const InputFrame& frame) {
+    uint16_t flags = frame.flags;
+    bool mouseMoved = frame.mousePos.x != lastMousePos.x || frame.mousePos.y != lastMousePos.y;
+    if (mouseMoved) flags |= cFileFlag_MouseMoved;
+    if (!frame.chars.empty()) flags |= cFileFlag_Chars;
+    if (!frame.droppedFiles.empty()) flags |= cFileFlag_DroppedFiles;
+    if (!frame.publishedJobs.empty()) flags |= cFileFlag_PublishedJobs;
+
+    WriteValue(file, flags);
+
+    if (mouseMoved) {
+        WriteValue(file, frame.mousePos.x);
+        WriteValue(file, frame.mousePos.y);
+        lastMousePos = frame.mousePos;
+    }
+
+    if (frame.isResized()) {
+        WriteValue(file, (int16_t)frame.screenWidth);
+        WriteValue(file, (int16_t)frame.screenHeight);
+    }
+
+    if (!frame.chars.empty()) {
+        WriteValue(file, (uint8_t)frame.chars.size());
+        file.write(frame.chars.data(), (uint8_t)frame.chars.size());
+    }
+
+    if (!frame.droppedFiles.empty()) {
+        WriteValue(file, (uint16_t)frame.droppedFiles.size());
+        for (const std::string& path : frame.droppedFiles) {
+            WriteValue(file, (uint16_t)path.size());
+            file.write(path.data(), (uint16_t)path.size());
+        }
+    }
+
+    if (!frame.publishedJobs.empty()) {
+        WriteValue(file, (uint16_t)frame.publishedJobs.size());
+        for (uint32_t id : frame.publishedJobs)
+            WriteValue(file, id);
+    }
+}
+
+bool InputReplay::open(const char* path) {
+    file.open(path, std::ios::binary);
+    if (!file) return false;
+
+    char magic[sizeof(cMagic)];
+    uint8_t version;
+    if (!file.read(magic, sizeof(magic)) || !ReadValue(file, version)) return false;
+    if (!std::equal(magic, magic + sizeof(magic), cMagic) || version != cVersion) return false;
+
+    int16_t width, height;
+    int32_t keys;
+    if (!ReadValue(file, width) || !ReadValue(file, height) || !ReadValue(file, keys)) return false;
+    screenWidth = width;
+    screenHeight = height;
+    keyCount = keys;
+    return true;
+}
+
+bool InputReplay::next(InputFrame& frame) {
+    uint16_t flags;
+    if (!ReadValue(file, flags)) return false;
+
+    frame = InputFrame();
+    frame.flags = flags & ~cFileFlags;
+
+    if (flags & cFileFlag_MouseMoved) {
+        if (!ReadValue(file, lastMousePos.x) || !ReadValue(file, lastMousePos.y)) return false;
+    }
+    frame.mousePos = lastMousePos;
+
+    if (frame.isResized()) {
+        int16_t width, height;
+        if (!ReadValue(file, width) || !ReadValue(file, height)) return false;
+        frame.screenWidth = width;
+        frame.screenHeight = height;
+    }
+
+    if (flags & cFileFlag_Chars) {
+        uint8_t count;
+        if (!ReadValue(file, count)) return false;
+        frame.chars.resize(count);
+        if (!file.read(frame.chars.data(), count)) return false;
+    }
+
+    if (flags & cFileFlag_DroppedFiles) {
+        uint16_t count;
+        if (!ReadValue(file, count)) return false;
+        frame.droppedFiles.resize(count);
+        for (std::string& path : frame.droppedFiles) {
+            uint16_t length;
+            if (!ReadValue(file, length)) return false;
+            path.resize(length);
+            if (!file.read(path.data(), length)) return false;
+        }
+    }
+
+    if (flags & cFileFlag_PublishedJobs) {
+        uint16_t count;
+        if (!ReadValue(file, count)) return false;
+        frame.publishedJobs.resize(count);
+        for (uint32_t& id : frame.publishedJobs) {
+            if (!ReadValue(file, id)) return false;
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+// Everything the editor reads from the mouse, keyboard and window in one frame. All update code
+// takes one of these instead of calling raylib directly, so a session can be recorded and replayed
+// without a window.
+struct InputFrame {
+    enum Flag : uint16_t {
+        cFlag_LeftPressed      = 1 << 0,
+        cFlag_LeftReleased     = 1 << 1,
+        cFlag_RightPressed     = 1 << 2,
+        cFlag_ShiftDown        = 1 << 3,
+        cFlag_BackspacePressed = 1 << 4,
+        cFlag_EnterPressed     = 1 << 5,
+        cFlag_PeriodPressed    = 1 << 6,
+        cFlag_Resized          = 1 << 7,
+        cFlag_CtrlDown         = 1 << 8,
+    };
+
+    bool isMouseButtonPressed(int button) const;
+    bool isMouseButtonReleased(int button) const;
+    bool isKeyDown(int key) const;
+    bool isKeyPressed(int key) const;
+
+    bool isResized() const {
+        return flags & cFlag_Resized;
+    }
+
+    uint16_t flags = 0;
+    Vector2 mousePos = { 0.0f, 0.0f };
+    int screenWidth = 0;
+    int screenHeight = 0;
+    // characters typed this frame, in the order GetCharPressed returned them
+    std::string chars;
+    // paths of the files dropped onto the window this frame
+    std::vector<std::string> droppedFiles;
+    // ids of the jobs whose results were applied right before this frame's update. not polled, the
+    // main loop fills it in so a replay can apply them at the same frame.
+    std::vector<uint32_t> publishedJobs;
+};
+
+// reads the current frame's input from raylib, needs a window
+InputFrame PollInput();
+
+// Writes frames to a compact binary file: a header with the screen size the session started at and the
+// size of the generated starting curve (0 for the default one), then
+// a 2 byte flag word per frame, followed by the mouse position only when it moved, and the typed
+// characters, dropped file paths and published job ids only when there were any.
+struct InputRecorder {
+    bool open(const char* path, int screenWidth, int screenHeight, int keyCount);
+    void write(const InputFrame& frame);
+
+    std::ofstream file;
+    Vector2 lastMousePos = { 0.0f, 0.0f };
+};
+
+struct InputReplay {
+    bool open(const char* path);
+    // returns false once the recording has run out
+    bool next(InputFrame& frame);
+
+    // the screen size at the start of the recording and the --keys count it was made with, read by open
+    int screenWidth = 0;
+    int screenHeight = 0;
+    int keyCount = 0;
+
+    std::ifstream file;
+    Vector2 lastMousePos = { 0.0f, 0.0f };
+};
\ No newline at end of file
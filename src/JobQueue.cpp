@@ -0,0 +1,95 @@
+#include "JobQueue.h"
+#include "Graph.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+
+#include "raylib.h"
+
+uint32_t JobQueue::submit(const std::string& name, Job::Work work) {
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->id = nextId++;
+    job->name = name;
+    job->work = std::move(work);
+    activeJobs.push_back(job);
+
+    pool.submit([this, job](){
+        try {
+            if (!job->isCancelled)
+                job->publish = job->work(*job);
+        } catch (const std::exception& e) {
+            job->publish = nullptr;
+            job->error = e.what();
+        }
+        job->progress = 1.0f;
+
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        finishedJobs.push_back(job);
+    });
+
+    return job->id;
+}
+
+void JobQueue::cancelAll() {
+    for (const std::shared_ptr<Job>& job : activeJobs)
+        job->isCancelled = true;
+}
+
+void JobQueue::retire(Graph& graph, const std::shared_ptr<Job>& job) {
+    if (!job->error.empty())
+        fprintf(stderr, "%s failed: %s\n", job->name.c_str(), job->error.c_str());
+    else if (!job->isCancelled && job->publish)
+        job->publish(graph);
+
+    activeJobs.erase(std::remove(activeJobs.begin(), activeJobs.end(), job), activeJobs.end());
+}
+
+std::vector<uint32_t> JobQueue::publish(Graph& graph) {
+    std::vector<std::shared_ptr<Job>> finished;
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        finished.swap(finishedJobs);
+    }
+
+    std::vector<uint32_t> ids;
+    for (const std::shared_ptr<Job>& job : finished) {
+        retire(graph, job);
+        ids.push_back(job->id);
+    }
+    return ids;
+}
+
+void JobQueue::publish(Graph& graph, const std::vector<uint32_t>& ids) {
+    if (ids.empty()) return;
+
+    // the jobs' results don't depend on when they finish, only on when they are applied
+    pool.wait();
+
+    std::vector<std::shared_ptr<Job>> finished;
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        for (uint32_t id : ids) {
+            auto it = std::find_if(finishedJobs.begin(), finishedJobs.end(),
+                [id](const std::shared_ptr<Job>& job) { return job->id == id; });
+            if (it == finishedJobs.end()) continue;
+            finished.push_back(*it);
+            finishedJobs.erase(it);
+        }
+    }
+
+    for (const std::shared_ptr<Job>& job : finished)
+        retire(graph, job);
+}
+
+void JobQueue::draw(const Font& font, Vector2 pos) const {
+    const Vector2 barSize = { 150.0f, 20.0f };
+
+    for (const std::shared_ptr<Job>& job : activeJobs) {
+        DrawRectangleRounded({ pos.x, pos.y, barSize.x, barSize.y }, 1.0f, 10, LIGHTGRAY);
+        DrawRectangleRounded({ pos.x, pos.y, barSize.x * job->progress, barSize.y }, 1.0f, 10, job->isCancelled ? GRAY : GREEN);
+        DrawTextEx(font, job->name.c_str(), { pos.x + barSize.x + 10.0f, pos.y - 2.0f }, font.baseSize, 1.0f, job->isCancelled ? GRAY : BLACK);
+        pos.y += barSize.y + 5.0f;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "KeyFrame.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+struct Graph;
+
+// keyframe data handed to jobs, which is never modified once taken
+using KeyFrameSnapshot = std::shared_ptr<const std::vector<KeyFrame>>;
+
+struct Job {
+    // runs on the main thread at a frame boundary to apply the job's result
+    using Publish = std::function<void(Graph&)>;
+    // runs on a worker thread, should check isCancelled and update progress as it goes
+    using Work = std::function<Publish(Job&)>;
+
+    // assigned in submission order, which recordings use to name the job
+    uint32_t id = 0;
+    std::string name;
+    Work work;
+    Publish publish;
+    // set instead of publish when work throws
+    std::string error;
+
+    std::atomic<float> progress = 0.0f;
+    std::atomic<bool> isCancelled = false;
+};
+
+// Runs heavy operations (exporting, loading, fitting) on worker threads so the frame loop never waits
+// on them. Results are only applied to the graph by publish(), which the main loop calls once per frame.
+struct JobQueue {
+    explicit JobQueue(int threadCount = 2) : pool(threadCount) {}
+
+    ~JobQueue() {
+        cancelAll();
+    }
+
+    // returns the new job's id
+    uint32_t submit(const std::string& name, Job::Work work);
+    void cancelAll();
+
+    // applies the results of finished jobs and reports failed ones, must be called from the main thread.
+    // returns the ids of the jobs it retired, in the order they were applied.
+    std::vector<uint32_t> publish(Graph& graph);
+    // applies exactly the given jobs in the given order, waiting for them to finish first, so a replay
+    // publishes results at the same frames as the recorded session did
+    void publish(Graph& graph, const std::vector<uint32_t>& ids);
+
+    void draw(const Font& font, Vector2 pos) const;
+
+private:
+    // applies a finished job's result unless it failed or was cancelled
+    void retire(Graph& graph, const std::shared_ptr<Job>& job);
+
+    // only touched by the main thread
+    std::vector<std::shared_ptr<Job>> activeJobs;
+    uint32_t nextId = 0;
+
+    std::mutex finishedMutex;
+    std::vector<std::shared_ptr<Job>> finishedJobs;
+
+    // declared last so the workers are joined before anything they use is destroyed
+    ThreadPool pool;
+};
\ No newline at end of file
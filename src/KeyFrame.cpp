@@ -10,9 +10,9 @@ const Vector2 KeyFrame::getScreenPos(const Graph& graph) const {
     return graph.coordToScreenPos(getPos());
 }
 
-bool KeyFrame::isClicked(const Graph& graph, const Vector2& mousePos) const {
+bool KeyFrame::isClicked(const Graph& graph, const InputFrame& input) const {
     Vector2 screenPos = getScreenPos(graph);
-    return IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && frame <= graph.frameCount && IsPointInCircle(mousePos, getScreenPos(graph), RADIUS * 2);
+    return input.isMouseButtonPressed(MOUSE_BUTTON_LEFT) && frame <= graph.frameCount && IsPointInCircle(input.mousePos, screenPos, RADIUS * 2);
 }
 
 const Vector2 KeyFrame::getSlopeControlPos(const Graph& graph, Control control) const {
@@ -27,14 +27,14 @@ const Vector2 KeyFrame::getSlopeControlPos(const Graph& graph, Control control)
         return { 0.0f, 0.0f };
 }
 
-void KeyFrame::draw(const Graph& graph, bool isSelected) const {
+void KeyFrame::draw(const Graph& graph, bool showControls) const {
     Vector2 screenPos = getScreenPos(graph);
 
     if (frame > graph.frameCount) return;
 
     DrawCircleV(screenPos, RADIUS, isSelected ? ORANGE : RED);
 
-    if (isSelected) {
+    if (showControls) {
         Vector2 leftControlPos = getSlopeControlPos(graph, Control::LEFT);
         Vector2 rightControlPos = getSlopeControlPos(graph, Control::RIGHT);
         DrawLineEx(leftControlPos, rightControlPos, 2, RED);
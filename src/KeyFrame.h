@@ -4,6 +4,7 @@
 #include "rcamera.h"
 
 struct Graph;
+struct InputFrame;
 
 struct KeyFrame {
     enum class Control {
@@ -22,13 +23,14 @@ struct KeyFrame {
         return { (float)frame, value };
     }
 
-    bool isClicked(const Graph& graph, const Vector2& mousePos) const;
+    bool isClicked(const Graph& graph, const InputFrame& input) const;
 
     const Vector2 getSlopeControlPos(const Graph& graph, Control control) const;
 
-    void draw(const Graph& graph, bool isSelected) const;
+    void draw(const Graph& graph, bool showControls) const;
     
     int frame;
     float value;
     float slope;
+    bool isSelected = false;
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "Layout.h"
+#include "Graph.h"
+#include "utils.h"
+
+#include "raylib.h"
+
+static Vector2 GetAnchorPos(const Graph& graph, LayoutAnchor anchor) {
+    switch (anchor) {
+    case LayoutAnchor::SCREEN:             return { 0.0f, 0.0f };
+    case LayoutAnchor::GRAPH_TOP_LEFT:     return { graph.left, graph.top };
+    case LayoutAnchor::GRAPH_TOP_RIGHT:    return { graph.right, graph.top };
+    case LayoutAnchor::GRAPH_BOTTOM_LEFT:  return { graph.left, graph.bottom };
+    case LayoutAnchor::GRAPH_BOTTOM_RIGHT: return { graph.right, graph.bottom };
+    }
+    return { 0.0f, 0.0f };
+}
+
+void Layout::add(Button& button) {
+    buttons.push_back(&button);
+    dirty = true;
+}
+
+void Layout::add(FloatInput& input) {
+    inputs.push_back(&input);
+    dirty = true;
+}
+
+void Layout::relayout(const Graph& graph) {
+    hitRects.clear();
+
+    for (Button* button : buttons) {
+        Vector2 anchorPos = GetAnchorPos(graph, button->layoutAnchor);
+        button->pos = { anchorPos.x + button->offset.x, anchorPos.y + button->offset.y };
+        hitRects.push_back({ button->getRect(), button, nullptr });
+    }
+
+    for (FloatInput* input : inputs) {
+        Vector2 anchorPos = GetAnchorPos(graph, input->layoutAnchor);
+        input->setPos({ anchorPos.x + input->offset.x, anchorPos.y + input->offset.y });
+        hitRects.push_back({ input->getRect(), nullptr, input });
+    }
+
+    dirty = false;
+}
+
+const Layout::HitRect* Layout::hitTest(const Vector2& mousePos) const {
+    // iterate backwards so that widgets drawn last win
+    for (auto it = hitRects.rbegin(); it != hitRects.rend(); it++) {
+        if (IsPointInRect(mousePos, it->rect))
+            return &*it;
+    }
+    return nullptr;
+}
+
+void Layout::update(const Graph& graph, const InputFrame& input) {
+    if (dirty) relayout(graph);
+
+    if (focusedInput != nullptr) {
+        if (focusedInput->update(input)) dirty = true;
+        if (focusedInput->state != FloatInput::State::CLICKED) focusedInput = nullptr;
+    }
+
+    if (input.isMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        const HitRect* hit = hitTest(input.mousePos);
+
+        if (focusedInput != nullptr && (hit == nullptr || hit->input != focusedInput)) {
+            if (focusedInput->unfocus()) dirty = true;
+            focusedInput = nullptr;
+        }
+
+        if (hit != nullptr && hit->button != nullptr) {
+            pressedButton = hit->button;
+            pressedButton->press();
+        } else if (hit != nullptr && hit->input != nullptr) {
+            hit->input->focus();
+            if (hit->input->state == FloatInput::State::CLICKED) focusedInput = hit->input;
+        }
+    }
+
+    if (input.isMouseButtonReleased(MOUSE_BUTTON_LEFT) && pressedButton != nullptr) {
+        pressedButton->release();
+        pressedButton = nullptr;
+    }
+}
+
+void Layout::draw() const {
+    for (const Button* button : buttons)
+        button->draw();
+
+    for (const FloatInput* input : inputs)
+        input->draw();
+}
\ No newline at end of file
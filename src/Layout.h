@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Button.h"
+#include "FloatInput.h"
+#include "Input.h"
+
+#include <vector>
+
+#include "raylib.h"
+
+struct Graph;
+
+// Retained layout for the widgets around the graph. Positions and hit rects are only recomputed
+// after a resize or a text change, and mouse input is dispatched with a single hit-test over the
+// cached rects instead of every widget polling the mouse each frame.
+struct Layout {
+    void add(Button& button);
+    void add(FloatInput& input);
+
+    // must be called whenever the graph is resized or a widget's text is changed from outside
+    void invalidate() {
+        dirty = true;
+    }
+
+    void update(const Graph& graph, const InputFrame& input);
+    void draw() const;
+
+private:
+    struct HitRect {
+        Rectangle rect;
+        Button* button;
+        FloatInput* input;
+    };
+
+    void relayout(const Graph& graph);
+    const HitRect* hitTest(const Vector2& mousePos) const;
+
+    std::vector<Button*> buttons;
+    std::vector<FloatInput*> inputs;
+    std::vector<HitRect> hitRects;
+
+    Button* pressedButton = nullptr;
+    FloatInput* focusedInput = nullptr;
+    bool dirty = true;
+};
\ No newline at end of file
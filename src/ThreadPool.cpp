@@ -0,0 +1,95 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+// index of the pool worker running on this thread, or -1 for any other thread
+static thread_local int sWorkerIndex = -1;
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 0; i < threadCount; i++)
+        queues.push_back(std::make_unique<Queue>());
+
+    for (int i = 0; i < threadCount; i++)
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        isStopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // tasks submitted from a worker stay on its own queue, others are spread round robin
+    int index = sWorkerIndex >= 0 ? sWorkerIndex : nextQueue++ % queues.size();
+
+    pendingCount++;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedCount++;
+    }
+    wakeCondition.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    doneCondition.wait(lock, [this](){ return pendingCount == 0; });
+}
+
+bool ThreadPool::popTask(int index, std::function<void()>& task) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::stealTask(int index, std::function<void()>& task) {
+    for (size_t i = 1; i < queues.size(); i++) {
+        Queue& queue = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int index) {
+    sWorkerIndex = index;
+
+    while (true) {
+        std::function<void()> task;
+
+        if (popTask(index, task) || stealTask(index, task)) {
+            queuedCount--;
+            task();
+
+            if (--pendingCount == 0) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                doneCondition.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this](){ return isStopping || queuedCount > 0; });
+        if (isStopping && queuedCount == 0) return;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Every worker has its own queue, takes new work from the back of it, and
+// steals from the front of the others' queues once it runs dry, so uneven tasks (e.g. files of very
+// different sizes) still keep all cores busy.
+struct ThreadPool {
+    // threadCount 0 uses one thread per hardware thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // blocks until every submitted task has finished
+    void wait();
+
+    int size() const {
+        return threads.size();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(int index);
+    bool popTask(int index, std::function<void()>& task);
+    bool stealTask(int index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    std::atomic<int> queuedCount = 0;
+    std::atomic<int> pendingCount = 0;
+    std::atomic<unsigned> nextQueue = 0;
+    bool isStopping = false;
+};
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "Thumbnail.h"
+#include "Curve.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "raylib.h"
+
+static constexpr int cLabelPadding = 4;
+
+bool LabelFont::load(const char* path, int size) {
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(path, &dataSize);
+    if (data == nullptr) return false;
+
+    // only the printable ASCII range, as labels are file and track names
+    glyphCount = 95;
+    glyphs = LoadFontData(data, dataSize, size, nullptr, glyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+    if (glyphs == nullptr) return false;
+
+    fontSize = size;
+    std::fill(asciiGlyphs, asciiGlyphs + 128, -1);
+
+    for (int i = 0; i < glyphCount; i++) {
+        GlyphInfo& glyph = glyphs[i];
+        if (glyph.value >= 0 && glyph.value < 128) asciiGlyphs[glyph.value] = i;
+
+        // the glyphs come as grayscale, turn them into white with the coverage as alpha so they blend
+        Image& image = glyph.image;
+        if (image.data == nullptr || image.format != PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) continue;
+
+        int pixelCount = image.width * image.height;
+        unsigned char* grayAlpha = (unsigned char*)MemAlloc(pixelCount * 2);
+        for (int p = 0; p < pixelCount; p++) {
+            grayAlpha[p * 2] = 255;
+            grayAlpha[p * 2 + 1] = ((unsigned char*)image.data)[p];
+        }
+
+        UnloadImage(image);
+        image.data = grayAlpha;
+        image.format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+    }
+
+    return true;
+}
+
+void LabelFont::unload() {
+    if (glyphs != nullptr) UnloadFontData(glyphs, glyphCount);
+    glyphs = nullptr;
+    glyphCount = 0;
+}
+
+int LabelFont::measure(const std::string& text) const {
+    int width = 0;
+    for (char c : text) {
+        int index = c >= 0 ? asciiGlyphs[(int)c] : -1;
+        if (index >= 0) width += glyphs[index].advanceX;
+    }
+    return width;
+}
+
+void LabelFont::draw(Image& dst, const std::string& text, Vector2 pos, Color color) const {
+    for (char c : text) {
+        int index = c >= 0 ? asciiGlyphs[(int)c] : -1;
+        if (index < 0) continue;
+
+        const GlyphInfo& glyph = glyphs[index];
+        if (glyph.image.data != nullptr && c != ' ') {
+            Rectangle srcRec = { 0, 0, (float)glyph.image.width, (float)glyph.image.height };
+            Rectangle dstRec = { pos.x + glyph.offsetX, pos.y + glyph.offsetY, (float)glyph.image.width, (float)glyph.image.height };
+            ImageDraw(&dst, glyph.image, srcRec, dstRec, color);
+        }
+        pos.x += glyph.advanceX;
+    }
+}
+
+Image RenderThumbnail(const Track& track, int width, int height) {
+    Image image = GenImageColor(width, height, RAYWHITE);
+
+    // grid
+    const int gridCount = 4;
+    for (int i = 1; i < gridCount; i++) {
+        int x = width * i / gridCount;
+        int y = height * i / gridCount;
+        ImageDrawLine(&image, x, 0, x, height - 1, LIGHTGRAY);
+        ImageDrawLine(&image, 0, y, width - 1, y, LIGHTGRAY);
+    }
+    ImageDrawRectangleLines(&image, { 0, 0, (float)width, (float)height }, 1, GRAY);
+
+    const std::vector<KeyFrame>& keyframes = track.keyframes;
+    if (keyframes.empty()) return image;
+
+    // fit both axes to the curve, using the exact bounds so overshoot stays inside the image
+    CurveBounds bounds;
+    bounds.rebuild(keyframes, track.interpolation);
+    float minValue = bounds.total.min;
+    float valueRange = bounds.total.max - bounds.total.min;
+    if (valueRange < 1e-6f) {
+        minValue -= 0.5f;
+        valueRange = 1.0f;
+    }
+
+    const float margin = 4.0f;
+    float plotHeight = height - margin * 2;
+    float firstFrame = keyframes.front().frame;
+    float frameRange = std::max(1, keyframes.back().frame - keyframes.front().frame);
+
+    auto toPixelY = [&](float value) {
+        return height - margin - (value - minValue) / valueRange * plotHeight;
+    };
+
+    // the zero line, if it is in view
+    if (minValue < 0.0f && minValue + valueRange > 0.0f) {
+        int zeroY = (int)toPixelY(0.0f);
+        ImageDrawLine(&image, 0, zeroY, width - 1, zeroY, GRAY);
+    }
+
+    // one sample per column, evaluated in a single pass over the keyframes
+    std::vector<float> samples(width);
+    SampleCurve(keyframes, track.interpolation, firstFrame, frameRange / (width - 1), width, samples.data());
+
+    int lastY = (int)toPixelY(samples[0]);
+    for (int x = 1; x < width; x++) {
+        int y = (int)toPixelY(samples[x]);
+        ImageDrawLine(&image, x - 1, lastY, x, y, DARKGREEN);
+        lastY = y;
+    }
+
+    for (const KeyFrame& keyframe : keyframes) {
+        int x = (int)((keyframe.frame - firstFrame) / frameRange * (width - 1));
+        int y = (int)toPixelY(keyframe.value);
+        ImageDrawRectangle(&image, x - 1, y - 1, 3, 3, RED);
+    }
+
+    return image;
+}
+
+Image RenderContactSheet(const Thumbnail* thumbnails, int count, int columns, const LabelFont& font) {
+    if (count == 0) return GenImageColor(1, 1, WHITE);
+
+    int thumbnailWidth = thumbnails[0].image.width;
+    int thumbnailHeight = thumbnails[0].image.height;
+    int cellWidth = thumbnailWidth + cLabelPadding * 2;
+    int cellHeight = thumbnailHeight + font.fontSize + cLabelPadding * 3;
+
+    columns = std::min(columns, count);
+    int rows = (count + columns - 1) / columns;
+    Image sheet = GenImageColor(columns * cellWidth, rows * cellHeight, WHITE);
+
+    for (int i = 0; i < count; i++) {
+        const Thumbnail& thumbnail = thumbnails[i];
+        float x = (i % columns) * cellWidth + cLabelPadding;
+        float y = (i / columns) * cellHeight + cLabelPadding;
+
+        Rectangle srcRec = { 0, 0, (float)thumbnail.image.width, (float)thumbnail.image.height };
+        ImageDraw(&sheet, thumbnail.image, srcRec, { x, y, srcRec.width, srcRec.height }, WHITE);
+
+        // cut long labels from the front, the end of the name is usually the interesting part
+        std::string label = thumbnail.label;
+        while (label.size() > 3 && font.measure(label) > thumbnailWidth)
+            label.erase(0, 1);
+
+        font.draw(sheet, label, { x, y + thumbnailHeight + cLabelPadding }, BLACK);
+    }
+
+    return sheet;
+}
\ No newline at end of file
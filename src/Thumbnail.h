@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CurveFile.h"
+
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+// Glyph images for drawing text straight into an Image. Unlike a regular Font it never creates a
+// texture, so it can be loaded and used without a window, from any thread.
+struct LabelFont {
+    bool load(const char* path, int fontSize);
+    void unload();
+
+    // advance of a string in pixels
+    int measure(const std::string& text) const;
+    void draw(Image& dst, const std::string& text, Vector2 pos, Color color) const;
+
+    GlyphInfo* glyphs = nullptr;
+    int glyphCount = 0;
+    int fontSize = 0;
+
+private:
+    // index into glyphs for each ASCII character, -1 if missing
+    int asciiGlyphs[128];
+};
+
+struct Thumbnail {
+    Image image;
+    std::string label;
+};
+
+// draws a track's grid and curve into a new CPU-side image
+Image RenderThumbnail(const Track& track, int width, int height);
+
+// lays out thumbnails in a grid with their labels underneath, as a single image
+Image RenderContactSheet(const Thumbnail* thumbnails, int count, int columns, const LabelFont& font);
\ No newline at end of file
@@ -0,0 +1,334 @@
+#include "Curve.h"
+#include "CurveFile.h"
+#include "KeyFrame.h"
+#include "ThreadPool.h"
+#include "Thumbnail.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct BatchOptions {
+    int resampleStep = 0;
+    float simplifyTolerance = -1.0f;
+    int threadCount = 0;
+    fs::path outputDir;
+    fs::path thumbnailDir;
+    std::string fontPath = "../assets/SourceCodePro-Regular.ttf";
+};
+
+static constexpr int cThumbnailWidth = 160;
+static constexpr int cThumbnailHeight = 90;
+static constexpr int cSheetColumns = 10;
+static constexpr int cSheetRows = 10;
+
+struct BatchJob {
+    fs::path input;
+    // path of the output relative to the output directory
+    fs::path relative;
+};
+
+struct BatchStats {
+    std::atomic<int> converted = 0;
+    std::atomic<int> failed = 0;
+    std::atomic<int> unsupported = 0;
+    std::atomic<int> skippedTracks = 0;
+    std::atomic<long long> keyframesIn = 0;
+    std::atomic<long long> keyframesOut = 0;
+    std::atomic<long long> bytesIn = 0;
+    std::atomic<long long> bytesOut = 0;
+};
+
+static std::mutex sLogMutex;
+
+static void logError(const fs::path& path, const std::string& message) {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    fprintf(stderr, "%s: %s\n", path.string().c_str(), message.c_str());
+}
+
+static bool readFile(const fs::path& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    out.resize(file.tellg());
+    file.seekg(0);
+    return (bool)file.read(out.data(), out.size());
+}
+
+static bool writeFile(const fs::path& path, const std::string& data) {
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    return file && file.write(data.data(), data.size());
+}
+
+// thumbnailTracks is only set when thumbnails were asked for, and receives the file's processed tracks
+static void processFile(const BatchJob& job, const BatchOptions& options, BatchStats& stats, std::vector<Track>* thumbnailTracks) {
+    if (job.input.extension() == ".bflan") {
+        logError(job.input, "BFLAN files are not supported yet, convert them to XML with LayoutLibrary.CLI first");
+        stats.unsupported++;
+        return;
+    }
+
+    // reused between files on the same worker, so the buffers only grow a few times per thread
+    thread_local std::string text;
+    thread_local std::string output;
+    thread_local CurveDocument document;
+
+    if (!readFile(job.input, text)) {
+        logError(job.input, "could not read file");
+        stats.failed++;
+        return;
+    }
+    stats.bytesIn += text.size();
+
+    std::string error;
+    if (!ParseCurveXml(std::move(text), document, error)) {
+        logError(job.input, error);
+        stats.failed++;
+        return;
+    }
+
+    bool isTransforming = options.resampleStep > 0 || options.simplifyTolerance >= 0.0f;
+    for (Track& track : document.tracks) {
+        stats.keyframesIn += track.keyframes.size();
+
+        // rounded keyframes would change the timing if transformed, and the curve functions need sorted ones
+        const char* skipReason = track.hasFractionalFrames ? "has fractional frames" :
+            track.hasUnsortedFrames ? "has keyframes out of order" : nullptr;
+
+        if (isTransforming && skipReason != nullptr) {
+            logError(job.input, "track '" + track.name + "' " + skipReason + ", left unchanged");
+            stats.skippedTracks++;
+        } else if (isTransforming) {
+            if (options.resampleStep > 0)
+                track.keyframes = ResampleCurve(track.keyframes, options.resampleStep, track.interpolation);
+            if (options.simplifyTolerance >= 0.0f)
+                track.keyframes = SimplifyCurve(track.keyframes, options.simplifyTolerance, track.interpolation);
+            track.isModified = true;
+        }
+
+        stats.keyframesOut += track.keyframes.size();
+    }
+
+    output.clear();
+    WriteCurveXml(document, output);
+    stats.bytesOut += output.size();
+
+    if (!options.outputDir.empty() && !writeFile(options.outputDir / job.relative, output)) {
+        logError(job.input, "could not write output");
+        stats.failed++;
+        return;
+    }
+
+    text = std::move(document.text);
+    stats.converted++;
+
+    if (thumbnailTracks != nullptr) {
+        std::string stem = fs::path(job.relative).replace_extension().string();
+        for (Track& track : document.tracks) {
+            track.name = stem + ":" + track.name;
+            thumbnailTracks->push_back(std::move(track));
+        }
+    }
+}
+
+// renders one contact sheet's worth of tracks and writes it out as a PNG
+static bool renderSheet(const std::vector<const Track*>& tracks, const LabelFont& font, const fs::path& path) {
+    std::vector<Thumbnail> thumbnails;
+    thumbnails.reserve(tracks.size());
+    for (const Track* track : tracks)
+        thumbnails.push_back({ RenderThumbnail(*track, cThumbnailWidth, cThumbnailHeight), track->name });
+
+    Image sheet = RenderContactSheet(thumbnails.data(), thumbnails.size(), cSheetColumns, font);
+    bool ok = ExportImage(sheet, path.string().c_str());
+
+    UnloadImage(sheet);
+    for (Thumbnail& thumbnail : thumbnails)
+        UnloadImage(thumbnail.image);
+
+    return ok;
+}
+
+static void renderThumbnails(const std::vector<std::vector<Track>>& fileTracks, const BatchOptions& options, ThreadPool& pool) {
+    LabelFont font;
+    if (!font.load(options.fontPath.c_str(), 14)) {
+        fprintf(stderr, "%s: could not load font for labels\n", options.fontPath.c_str());
+        return;
+    }
+
+    std::error_code ec;
+    fs::create_directories(options.thumbnailDir, ec);
+
+    std::vector<const Track*> tracks;
+    for (const std::vector<Track>& file : fileTracks) {
+        for (const Track& track : file)
+            tracks.push_back(&track);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    const size_t perSheet = cSheetColumns * cSheetRows;
+    std::atomic<int> failedSheets = 0;
+    int sheetCount = (tracks.size() + perSheet - 1) / perSheet;
+    for (int sheetIndex = 0; sheetIndex < sheetCount; sheetIndex++) {
+        pool.submit([&, sheetIndex](){
+            auto first = tracks.begin() + sheetIndex * perSheet;
+            std::vector<const Track*> sheetTracks(first, first + std::min(perSheet, tracks.size() - sheetIndex * perSheet));
+
+            char fileName[32];
+            snprintf(fileName, sizeof(fileName), "sheet_%04d.png", sheetIndex);
+            if (!renderSheet(sheetTracks, font, options.thumbnailDir / fileName)) {
+                logError(options.thumbnailDir / fileName, "could not write contact sheet");
+                failedSheets++;
+            }
+        });
+    }
+    pool.wait();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("thumbnails: %zu on %d sheets (%d failed) in %.3f s, %.0f thumbnails/s\n", tracks.size(), sheetCount, failedSheets.load(), seconds, tracks.size() / seconds);
+
+    font.unload();
+}
+
+static bool isCurveFile(const fs::path& path) {
+    return path.extension() == ".xml" || path.extension() == ".bflan";
+}
+
+// walks dir by hand rather than with recursive_directory_iterator, so that a directory that can't be
+// read is reported and skipped instead of ending the whole batch
+static void collectDirectory(const fs::path& root, const fs::path& dir, std::vector<BatchJob>& jobs) {
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        const fs::directory_entry& entry = *it;
+        std::error_code entryError;
+
+        // like recursive_directory_iterator, symlinked directories aren't followed so links can't loop
+        if (entry.is_directory(entryError) && !entry.is_symlink(entryError)) {
+            collectDirectory(root, entry.path(), jobs);
+        } else if (entry.is_regular_file(entryError) && isCurveFile(entry.path())) {
+            jobs.push_back({ entry.path(), entry.path().lexically_relative(root) });
+        }
+    }
+
+    if (ec) logError(dir, "could not read directory: " + ec.message());
+}
+
+static void collectJobs(const fs::path& input, std::vector<BatchJob>& jobs) {
+    std::error_code ec;
+    if (!fs::is_directory(input, ec)) {
+        jobs.push_back({ input, input.filename() });
+        return;
+    }
+
+    collectDirectory(input, input, jobs);
+}
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+        "usage: %s [options] <file or directory>...\n"
+        "  -o <dir>            write converted files to <dir>, keeping the input layout\n"
+        "  --bake              put a keyframe on every frame\n"
+        "  --resample <step>   put a keyframe every <step> frames\n"
+        "  --simplify <tol>    remove keyframes while the curve stays within <tol> of the original\n"
+        "  --threads <count>   number of worker threads (default: all hardware threads)\n"
+        "  --thumbnails <dir>  draw every track into contact sheet PNGs in <dir>\n"
+        "  --font <path>       font for the contact sheet labels (default: ../assets/SourceCodePro-Regular.ttf)\n",
+        program
+    );
+}
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    std::vector<fs::path> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            options.outputDir = argv[++i];
+        } else if (arg == "--bake") {
+            options.resampleStep = 1;
+        } else if (arg == "--resample" && i + 1 < argc) {
+            options.resampleStep = atoi(argv[++i]);
+        } else if (arg == "--simplify" && i + 1 < argc) {
+            options.simplifyTolerance = atof(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threadCount = atoi(argv[++i]);
+        } else if (arg == "--thumbnails" && i + 1 < argc) {
+            options.thumbnailDir = argv[++i];
+        } else if (arg == "--font" && i + 1 < argc) {
+            options.fontPath = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<BatchJob> jobs;
+    for (const fs::path& input : inputs) {
+        std::error_code ec;
+        if (!fs::exists(input, ec)) {
+            fprintf(stderr, "%s: no such file or directory\n", input.string().c_str());
+            return 1;
+        }
+        collectJobs(input, jobs);
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    BatchStats stats;
+    bool wantsThumbnails = !options.thumbnailDir.empty();
+    std::vector<std::vector<Track>> fileTracks(wantsThumbnails ? jobs.size() : 0);
+    auto start = std::chrono::steady_clock::now();
+
+    {
+        ThreadPool pool(options.threadCount);
+        for (size_t i = 0; i < jobs.size(); i++) {
+            std::vector<Track>* thumbnailTracks = wantsThumbnails ? &fileTracks[i] : nullptr;
+            pool.submit([&job = jobs[i], &options, &stats, thumbnailTracks](){
+                // an exception escaping a pool task would end the whole batch, so it only fails this file
+                try {
+                    processFile(job, options, stats, thumbnailTracks);
+                } catch (const std::exception& e) {
+                    logError(job.input, e.what());
+                    stats.failed++;
+                }
+            });
+        }
+        pool.wait();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double megabytes = stats.bytesIn / (1024.0 * 1024.0);
+
+        printf("files:      %d converted, %d failed, %d unsupported\n", stats.converted.load(), stats.failed.load(), stats.unsupported.load());
+        printf("keyframes:  %lld in, %lld out\n", stats.keyframesIn.load(), stats.keyframesOut.load());
+        if (stats.skippedTracks > 0)
+            printf("tracks:     %d left unchanged for having fractional or out of order frames\n", stats.skippedTracks.load());
+        printf("threads:    %d\n", pool.size());
+        printf("time:       %.3f s\n", seconds);
+        printf("throughput: %.1f files/s, %.0f keyframes/s, %.1f MB/s\n", jobs.size() / seconds, stats.keyframesIn / seconds, megabytes / seconds);
+
+        if (wantsThumbnails)
+            renderThumbnails(fileTracks, options, pool);
+    }
+
+    return stats.failed > 0 ? 1 : 0;
+}
\ No newline at end of file
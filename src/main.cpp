@@ -1,83 +1,419 @@
 #include "Graph.h"
 #include "Button.h"
+#include "Curve.h"
+#include "CurveFile.h"
+#include "Input.h"
+#include "JobQueue.h"
 #include "KeyFrame.h"
+#include "Layout.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+
 #include "raylib.h"
 #include "rcamera.h"
 
-void initButtons(Graph& graph, std::vector<Button>& buttons) {
-    Button frameCountUpButton =   { graph.font, "+", { graph.right + 30, graph.bottom - 20 }, { 20, 20 } };
-    Button frameCountDownButton = { graph.font, "-", { graph.right + 30, graph.bottom + 20 }, { 20, 20 } };
+// relative to the build directory the editor is run from
+static constexpr const char* cFontPath = "../assets/SourceCodePro-Regular.ttf";
+static constexpr int cFontSize = 25;
+
+// buttons that transform every selected keyframe by the amount in graph.bulkAmountInput, in a row under the graph's right edge
+void initBulkButtons(Graph& graph, std::vector<Button>& buttons) {
+    Button timeOffsetButton = { graph.font, "Time +",  { 0, 0 }, { 0, 0 } };
+    Button timeScaleButton =  { graph.font, "Time *",  { 0, 0 }, { 0, 0 } };
+    Button valueOffsetButton = { graph.font, "Value +", { 0, 0 }, { 0, 0 } };
+    Button valueScaleButton = { graph.font, "Value *", { 0, 0 }, { 0, 0 } };
+    Button slopeScaleButton = { graph.font, "Slope *", { 0, 0 }, { 0, 0 } };
+
+    timeOffsetButton.onClick = [&graph](){
+        graph.offsetSelectedFrames((int)std::lround(graph.bulkAmountInput->value));
+    };
+
+    timeScaleButton.onClick = [&graph](){
+        const KeyFrame* pivot = graph.getPivotKeyframe();
+        if (pivot != nullptr) graph.scaleSelectedFrames(graph.bulkAmountInput->value, pivot->frame);
+    };
+
+    valueOffsetButton.onClick = [&graph](){
+        graph.offsetSelectedValues(graph.bulkAmountInput->value);
+    };
+
+    valueScaleButton.onClick = [&graph](){
+        const KeyFrame* pivot = graph.getPivotKeyframe();
+        if (pivot != nullptr) graph.scaleSelectedValues(graph.bulkAmountInput->value, pivot->value);
+    };
+
+    slopeScaleButton.onClick = [&graph](){
+        graph.scaleSelectedSlopes(graph.bulkAmountInput->value);
+    };
+
+    std::vector<Button> row = { timeOffsetButton, timeScaleButton, valueOffsetButton, valueScaleButton, slopeScaleButton };
+
+    float offsetX = 0.0f;
+    for (auto it = row.rbegin(); it != row.rend(); it++) {
+        offsetX -= it->size.x;
+        it->offset = { offsetX, 100 };
+        it->layoutAnchor = LayoutAnchor::GRAPH_BOTTOM_RIGHT;
+        offsetX -= 10.0f;
+    }
+
+    for (const Button& button : row)
+        buttons.push_back(button);
+}
+
+void initButtons(Graph& graph, Layout& layout, JobQueue& jobs, std::vector<Button>& buttons) {
+    Button frameCountUpButton =   { graph.font, "+", { 30, -20 }, { 20, 20 } };
+    Button frameCountDownButton = { graph.font, "-", { 30,  20 }, { 20, 20 } };
+    frameCountUpButton.layoutAnchor = LayoutAnchor::GRAPH_BOTTOM_RIGHT;
+    frameCountDownButton.layoutAnchor = LayoutAnchor::GRAPH_BOTTOM_RIGHT;
 
     Button addButton =    { graph.font, "Add keyframe",             { 100, 30 },                                           { 0, 0 } };
-    Button deleteButton = { graph.font, "Delete selected keyframe", {    addButton.pos.x +    addButton.size.x + 20, 30 }, { 0, 0 } };
+    Button deleteButton = { graph.font, "Delete selected",          {    addButton.pos.x +    addButton.size.x + 20, 30 }, { 0, 0 } };
     Button clearButton =  { graph.font, "Clear all keyframes",      { deleteButton.pos.x + deleteButton.size.x + 20, 30 }, { 0, 0 } };
     Button copyButton =   { graph.font, "Copy to clipboard",        {  clearButton.pos.x +  clearButton.size.x + 20, 30 }, { 0, 0 } };
+    Button autoFitButton = { graph.font, "Auto-fit: off",           {   copyButton.pos.x +   copyButton.size.x + 20, 30 }, { 0, 0 } };
+    Button alphaButton =  { graph.font, "Alpha track: off",         { autoFitButton.pos.x + autoFitButton.size.x + 20, 30 }, { 0, 0 } };
+    Button curveButton =  { graph.font, "Curve: Hermite",           {  alphaButton.pos.x +  alphaButton.size.x + 20, 30 }, { 0, 0 } };
+    Button simplifyButton = { graph.font, "Simplify",               {  curveButton.pos.x +  curveButton.size.x + 20, 30 }, { 0, 0 } };
+
+    Button cancelJobsButton = { graph.font, "Cancel jobs", { 0, 60 }, { 0, 0 } };
+    cancelJobsButton.layoutAnchor = LayoutAnchor::GRAPH_BOTTOM_LEFT;
     
     frameCountUpButton.onClick = [&graph](){
-        graph.frameCount++;
-        graph.frameWidth = graph.width / graph.frameCount;
-    };
-
-    frameCountUpButton.onUpdate = [&graph](Button& thiz){
-        thiz.pos = { graph.right + 30, graph.bottom - 20 };
+        graph.setFrameCount(graph.frameCount + 1);
     };
 
     frameCountDownButton.onClick = [&graph](){
-        if (graph.frameCount > 0) {
-            graph.frameCount--;
-            graph.frameWidth = graph.width / graph.frameCount;
-        }
-    };
-
-    frameCountDownButton.onUpdate = [&graph](Button& thiz){
-        thiz.pos = { graph.right + 30, graph.bottom + 20 };
+        if (graph.frameCount > 0)
+            graph.setFrameCount(graph.frameCount - 1);
     };
 
     addButton.onClick = [&graph](){
         graph.isClickingNewKeyframe = true;
-        graph.selectedKeyframe = nullptr;
+        graph.clearSelection();
     };
 
     deleteButton.onClick = [&graph](){
         graph.isClickingNewKeyframe = false;
-        for (int i = 0; i < graph.keyframes.size(); i++) {
-            KeyFrame& keyframe = graph.keyframes[i];
-            if (&keyframe == graph.selectedKeyframe) {
-                graph.selectedKeyframe = nullptr;
-                graph.keyframes.erase(graph.keyframes.begin() + i);
-                break;
-            }
-        }
+        graph.deleteSelected();
     };
 
     clearButton.onClick = [&graph](){
         graph.isClickingNewKeyframe = false;
-        graph.selectedKeyframe = nullptr;
-        graph.keyframes.clear();
+        graph.setKeyframes({});
     };
 
-    copyButton.onClick = [&graph](){
+    copyButton.onClick = [&graph, &jobs](){
         if (graph.keyframes.empty()) return;
-        std::string output = "a";
-        for (const KeyFrame& keyframe : graph.keyframes) {
-            std::string addition = format("<KeyFrame Frame=\"%d\" Value=\"%f\" Slope=\"%f\"/>\n", keyframe.frame, keyframe.value, keyframe.slope);
-            output.pop_back();
-            output.append(addition);
-        }
-        SetClipboardText(output.c_str());
+
+        KeyFrameSnapshot snapshot = std::make_shared<const std::vector<KeyFrame>>(graph.keyframes);
+        jobs.submit("Copying to clipboard", [snapshot](Job& job) -> Job::Publish {
+            std::string output;
+            for (size_t i = 0; i < snapshot->size(); i++) {
+                if (i % 4096 == 0) {
+                    if (job.isCancelled) return nullptr;
+                    job.progress = (float)i / snapshot->size();
+                }
+
+                AppendKeyFrameXml(output, (*snapshot)[i]);
+                output.push_back('\n');
+            }
+
+            return [output = std::move(output)](Graph& graph){
+                if (IsWindowReady()) SetClipboardText(output.c_str());
+            };
+        });
     };
-    
+
+    simplifyButton.onClick = [&graph, &jobs](){
+        if (graph.keyframes.size() < 3) return;
+
+        KeyFrameSnapshot snapshot = std::make_shared<const std::vector<KeyFrame>>(graph.keyframes);
+        int revision = graph.revision;
+        Interpolation interpolation = graph.interpolation;
+        jobs.submit("Simplifying", [snapshot, revision, interpolation](Job& job) -> Job::Publish {
+            std::vector<KeyFrame> result = SimplifyCurve(*snapshot, 0.001f, interpolation, [&job](float progress){
+                job.progress = progress;
+                return !job.isCancelled;
+            });
+
+            return [result = std::move(result), revision](Graph& graph) mutable {
+                // drop the result if the curve was edited while the job was running
+                if (graph.revision == revision) graph.setKeyframes(std::move(result));
+            };
+        });
+    };
+
+    cancelJobsButton.onClick = [&jobs](){
+        jobs.cancelAll();
+    };
+
     buttons.push_back(addButton);
     buttons.push_back(deleteButton);
     buttons.push_back(clearButton);
     buttons.push_back(copyButton);
+
+    // the text of these buttons changes when clicked, so they have to find themselves again in the vector
+    autoFitButton.onClick = [&graph, &layout, &buttons, index = buttons.size()](){
+        graph.setAutoFit(!graph.autoFit);
+        buttons[index].setText(graph.autoFit ? "Auto-fit: on" : "Auto-fit: off");
+        layout.invalidate();
+    };
+    buttons.push_back(autoFitButton);
+
+    alphaButton.onClick = [&graph, &layout, &buttons, index = buttons.size()](){
+        graph.isAlphaTrack = !graph.isAlphaTrack;
+        buttons[index].setText(graph.isAlphaTrack ? "Alpha track: on" : "Alpha track: off");
+        layout.invalidate();
+    };
+    buttons.push_back(alphaButton);
+
+    // loading a file can change the mode too, so the text follows the graph rather than the clicks
+    curveButton.onClick = [&graph](){
+        graph.setInterpolation((Interpolation)(((int)graph.interpolation + 1) % 3));
+    };
+    graph.onInterpolationChanged = [&graph, &layout, &buttons, index = buttons.size()](){
+        buttons[index].setText(std::string("Curve: ") + GetInterpolationName(graph.interpolation));
+        layout.invalidate();
+    };
+    buttons.push_back(curveButton);
+
+    buttons.push_back(simplifyButton);
+    buttons.push_back(cancelJobsButton);
+
+    initBulkButtons(graph, buttons);
+
     buttons.push_back(frameCountUpButton);
     buttons.push_back(frameCountDownButton);
 }
 
-int main() {
+// parses a curve file in the background and replaces the graph's curve and interpolation with its first track
+void loadCurveFile(JobQueue& jobs, const std::string& path) {
+    std::string fileName = path.substr(path.find_last_of("/\\") + 1);
+
+    jobs.submit("Loading " + fileName, [path](Job& job) -> Job::Publish {
+        std::ifstream file(path, std::ios::binary);
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!file || job.isCancelled) return nullptr;
+        job.progress = 0.5f;
+
+        CurveDocument document;
+        std::string error;
+        if (!ParseCurveXml(std::move(text), document, error) || document.tracks.empty()) {
+            fprintf(stderr, "%s: %s\n", path.c_str(), error.empty() ? "no keyframes found" : error.c_str());
+            return nullptr;
+        }
+
+        // the graph expects one keyframe per frame in order, which files don't guarantee
+        Track& track = document.tracks[0];
+        std::stable_sort(track.keyframes.begin(), track.keyframes.end(),
+            [](const KeyFrame& a, const KeyFrame& b) { return a.frame < b.frame; });
+        track.keyframes.erase(std::unique(track.keyframes.begin(), track.keyframes.end(),
+            [](const KeyFrame& a, const KeyFrame& b) { return a.frame == b.frame; }), track.keyframes.end());
+
+        return [keyframes = std::move(track.keyframes), interpolation = track.interpolation](Graph& graph) mutable {
+            graph.setKeyframes(std::move(keyframes));
+            graph.setInterpolation(interpolation);
+        };
+    });
+}
+
+void updateFrame(Graph& graph, Layout& layout, JobQueue& jobs, const InputFrame& input) {
+    for (const std::string& path : input.droppedFiles)
+        loadCurveFile(jobs, path);
+
+    if (input.isResized()) {
+        graph.resize(input.screenWidth, input.screenHeight);
+        layout.invalidate();
+    }
+
+    layout.update(graph, input);
+
+    graph.update(input);
+}
+
+// replaces the graph's curve with a deterministic one of the given size, for benchmarking
+void generateKeyframes(Graph& graph, int keyCount) {
+    graph.keyframes.clear();
+    graph.selectedKeyframe = nullptr;
+    graph.draggingKeyframe = nullptr;
+
+    for (int i = 0; i < keyCount; i++) {
+        // unsigned, so large key counts wrap instead of overflowing
+        uint32_t index = i;
+        float value = 0.5f + 0.4f * ((int)(index * 7919u % 101) - 50) / 50.0f;
+        float slope = ((int)(index * 104729u % 21) - 10) / 10.0f;
+        graph.keyframes.push_back({ i, value, slope });
+    }
+
+    graph.frameCount = keyCount;
+    graph.frameWidth = graph.width / graph.frameCount;
+    graph.updateBounds();
+}
+
+// FNV-1a over the editor state that a session can change, to spot behaviour differences between replays
+uint64_t hashGraphState(const Graph& graph) {
+    uint64_t hash = 0xcbf29ce484222325;
+    auto mix = [&hash](const void* data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<const uint8_t*>(data)[i];
+            hash *= 0x100000001b3;
+        }
+    };
+
+    for (const KeyFrame& keyframe : graph.keyframes) {
+        mix(&keyframe.frame, sizeof(keyframe.frame));
+        mix(&keyframe.value, sizeof(keyframe.value));
+        mix(&keyframe.slope, sizeof(keyframe.slope));
+        mix(&keyframe.isSelected, sizeof(keyframe.isSelected));
+    }
+
+    int selectedIndex = graph.selectedKeyframe != nullptr ? graph.selectedKeyframe - graph.keyframes.data() : -1;
+    mix(&selectedIndex, sizeof(selectedIndex));
+    mix(&graph.selectionCount, sizeof(graph.selectionCount));
+    mix(&graph.interpolation, sizeof(graph.interpolation));
+    mix(&graph.frameCount, sizeof(graph.frameCount));
+    mix(&graph.yMin, sizeof(graph.yMin));
+    mix(&graph.yRange, sizeof(graph.yRange));
+
+    return hash;
+}
+
+// runs a recorded session through the update logic without opening a window, and reports timings
+int runReplay(const char* path) {
+    InputReplay replay;
+    if (!replay.open(path)) {
+        fprintf(stderr, "error: could not read input recording '%s'\n", path);
+        return 1;
+    }
+
+    // without a window there is no font texture, but the glyph metrics are enough for the layout to
+    // match the recorded session
+    Font font = LoadFontMetrics(cFontPath, cFontSize);
+    if (font.glyphs == nullptr) {
+        fprintf(stderr, "error: could not load font '%s'\n", cFontPath);
+        return 1;
+    }
+
+    Graph graph(font, replay.screenWidth, replay.screenHeight);
+    if (replay.keyCount > 0) generateKeyframes(graph, replay.keyCount);
+
+    Layout layout;
+    JobQueue jobs;
+    std::vector<Button> buttons;
+    initButtons(graph, layout, jobs, buttons);
+
+    for (Button& button : buttons)
+        layout.add(button);
+    layout.add(*graph.yRangeInput);
+    layout.add(*graph.bulkAmountInput);
+
+    int frameCount = 0;
+    double totalTime = 0.0;
+    double maxTime = 0.0;
+
+    InputFrame input;
+    while (replay.next(input)) {
+        jobs.publish(graph, input.publishedJobs);
+
+        auto start = std::chrono::steady_clock::now();
+        updateFrame(graph, layout, jobs, input);
+        double frameTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        totalTime += frameTime;
+        maxTime = std::max(maxTime, frameTime);
+        frameCount++;
+    }
+
+    printf("frames:     %d\n", frameCount);
+    printf("keyframes:  %zu\n", graph.keyframes.size());
+    printf("total:      %.3f ms\n", totalTime * 1000.0);
+    printf("mean frame: %.3f us\n", frameCount > 0 ? totalTime / frameCount * 1e6 : 0.0);
+    printf("max frame:  %.3f us\n", maxTime * 1e6);
+    printf("state hash: %016llx\n", (unsigned long long)hashGraphState(graph));
+
+    UnloadFontMetrics(font);
+    return 0;
+}
+
+// times every bulk transform on a generated curve with all of its keyframes selected, without a window
+int runBulkBenchmark(int keyCount) {
+    // nothing is laid out or drawn, so the font is never used
+    const Font font = {};
+    Graph graph(font, 1600, 900);
+    generateKeyframes(graph, keyCount);
+    graph.selectRange(graph.keyframes.front(), graph.keyframes.back());
+
+    // each pair undoes itself, so every run sees the same curve
+    struct Benchmark {
+        const char* name;
+        std::function<void()> apply;
+        std::function<void()> undo;
+    };
+    Benchmark benchmarks[] = {
+        { "Time +",  [&](){ graph.offsetSelectedFrames(1); },           [&](){ graph.offsetSelectedFrames(-1); } },
+        { "Time *",  [&](){ graph.scaleSelectedFrames(2.0f, 0.0f); },   [&](){ graph.scaleSelectedFrames(0.5f, 0.0f); } },
+        { "Value +", [&](){ graph.offsetSelectedValues(0.5f); },        [&](){ graph.offsetSelectedValues(-0.5f); } },
+        { "Value *", [&](){ graph.scaleSelectedValues(2.0f, 0.5f); },   [&](){ graph.scaleSelectedValues(0.5f, 0.5f); } },
+        { "Slope *", [&](){ graph.scaleSelectedSlopes(2.0f); },         [&](){ graph.scaleSelectedSlopes(0.5f); } },
+    };
+
+    const int runCount = 20;
+    printf("keyframes:  %zu, all selected\n", graph.keyframes.size());
+    for (const Benchmark& benchmark : benchmarks) {
+        double totalTime = 0.0;
+        for (int i = 0; i < runCount; i++) {
+            auto start = std::chrono::steady_clock::now();
+            benchmark.apply();
+            totalTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            benchmark.undo();
+        }
+        printf("%-10s  %.3f ms\n", (std::string(benchmark.name) + ":").c_str(), totalTime / runCount * 1000.0);
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    int keyCount = 0;
+    bool isBulkBenchmark = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--keys" && i + 1 < argc) {
+            keyCount = atoi(argv[++i]);
+        } else if (arg == "--bench-bulk") {
+            isBulkBenchmark = true;
+        } else {
+            fprintf(stderr, "usage: %s [--keys <count>] [--record <file>] | --replay <file> | --bench-bulk [--keys <count>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (isBulkBenchmark)
+        return runBulkBenchmark(keyCount > 0 ? keyCount : 100000);
+    if (replayPath != nullptr && keyCount > 0) {
+        // the recording already says which curve it started from
+        fprintf(stderr, "error: --keys can't be combined with --replay\n");
+        return 1;
+    }
+    if (replayPath != nullptr)
+        return runReplay(replayPath);
+
     int screenWidth = 1600;
     int screenHeight = 900;
 
@@ -88,26 +424,39 @@ int main() {
 
     SetTargetFPS(60);
 
-    const Font font = LoadFontEx("../assets/SourceCodePro-Regular.ttf", 25, nullptr, 0);
+    // opened once the window exists, so the header gets the size it actually came up with
+    InputRecorder recorder;
+    if (recordPath != nullptr && !recorder.open(recordPath, GetScreenWidth(), GetScreenHeight(), keyCount)) {
+        fprintf(stderr, "error: could not open '%s' for recording\n", recordPath);
+        CloseWindow();
+        return 1;
+    }
+
+    const Font font = LoadFontEx(cFontPath, cFontSize, nullptr, 0);
 
-    Graph graph(font, screenWidth, screenHeight);
+    Graph graph(font, GetScreenWidth(), GetScreenHeight());
+    if (keyCount > 0) generateKeyframes(graph, keyCount);
 
+    Layout layout;
+    JobQueue jobs;
     std::vector<Button> buttons;
-    initButtons(graph, buttons);
+    initButtons(graph, layout, jobs, buttons);
+
+    for (Button& button : buttons)
+        layout.add(button);
+    layout.add(*graph.yRangeInput);
+    layout.add(*graph.bulkAmountInput);
     
     while (!WindowShouldClose()) {
         // Update
         //----------------------------------------------------------------------------------
         
-        Vector2 mousePos = GetMousePosition();
-
-        if (IsWindowResized())
-            graph.resize(GetScreenWidth(), GetScreenHeight());
+        InputFrame input = PollInput();
+        input.publishedJobs = jobs.publish(graph);
+        if (recordPath != nullptr)
+            recorder.write(input);
 
-        for (Button& button : buttons)
-            button.update(mousePos);
-
-        graph.update(mousePos);
+        updateFrame(graph, layout, jobs, input);
 
 
         // Draw
@@ -118,8 +467,9 @@ int main() {
 
             graph.draw();
 
-            for (Button& button : buttons)
-                button.draw();
+            layout.draw();
+
+            jobs.draw(font, { graph.left, graph.bottom + 100.0f });
 
         EndDrawing();
     }
@@ -127,4 +477,4 @@ int main() {
     CloseWindow();
 
     return 0;
-}
+}
\ No newline at end of file
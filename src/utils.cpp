@@ -11,15 +11,73 @@ bool IsPointInRect(const Vector2& pointPos, const Vector2& rectPos, const Vector
     return pointPos.x >= rectLeft && pointPos.x <= rectRight && pointPos.y >= rectTop && pointPos.y <= rectBottom;
 }
 
+bool IsPointInRect(const Vector2& pointPos, const Rectangle& rect) {
+    return IsPointInRect(pointPos, { rect.x, rect.y }, { rect.width, rect.height });
+}
+
 bool IsPointInCircle(const Vector2& pointPos, const Vector2& circleCenter, float circleRadius) {
     return Vector2Distance(pointPos, circleCenter) < circleRadius;
 }
 
+Font LoadFontMetrics(const char* path, int fontSize) {
+    Font font = {};
+
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(path, &dataSize);
+    if (data == nullptr) return font;
+
+    // the same 95 ASCII glyphs LoadFontEx loads when it isn't given any codepoints
+    font.glyphCount = 95;
+    font.glyphs = LoadFontData(data, dataSize, fontSize, nullptr, font.glyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+    if (font.glyphs == nullptr) return Font{};
+
+    font.baseSize = fontSize;
+    font.recs = (Rectangle*)MemAlloc(font.glyphCount * sizeof(Rectangle));
+    for (int i = 0; i < font.glyphCount; i++) {
+        // the atlas rectangles are as big as the glyph images, which are not needed beyond that
+        Image& image = font.glyphs[i].image;
+        font.recs[i] = { 0.0f, 0.0f, (float)image.width, (float)image.height };
+        UnloadImage(image);
+        image.data = nullptr;
+    }
+
+    return font;
+}
+
+void UnloadFontMetrics(Font& font) {
+    UnloadFontData(font.glyphs, font.glyphCount);
+    MemFree(font.recs);
+    font = {};
+}
+
+Vector2 MeasureTextLine(const Font& font, const std::string& text, float spacing) {
+    if (font.glyphs == nullptr) return { 0.0f, 0.0f };
+
+    float width = 0.0f;
+    int codepointCount = 0;
+    for (size_t i = 0; i < text.size(); codepointCount++) {
+        int byteCount = 0;
+        int index = GetGlyphIndex(font, GetCodepointNext(text.c_str() + i, &byteCount));
+        i += byteCount > 0 ? byteCount : 1;
+
+        const GlyphInfo& glyph = font.glyphs[index];
+        width += glyph.advanceX != 0 ? glyph.advanceX : font.recs[index].width + glyph.offsetX;
+    }
+
+    if (codepointCount > 1) width += (codepointCount - 1) * spacing;
+    return { width, (float)font.baseSize };
+}
+
 bool DrawTextAnchor(const Font& font, const std::string& msg, const Vector2& pos, int anchorX, int anchorY, Color color) {
+    Vector2 textSize = MeasureTextEx(font, msg.c_str(), font.baseSize, 1.0f);
+    return DrawTextAnchor(font, msg, pos, textSize, anchorX, anchorY, color);
+}
+
+bool DrawTextAnchor(const Font& font, const std::string& msg, const Vector2& pos, const Vector2& textSize, int anchorX, int anchorY, Color color) {
     if (anchorX > 1 || anchorX < -1 || anchorY > 1 || anchorY < -1) return false;
 
     float spacing = 1.0f;
-    Vector2 textSize = MeasureTextEx(font, msg.c_str(), font.baseSize, spacing);
     Vector2 textPos = { pos.x + anchorX * textSize.x / 2, pos.y + anchorY * textSize.y / 2 };
     DrawTextPro(font, msg.c_str(), textPos, { textSize.x / 2, textSize.y / 2 }, 0.0f, font.baseSize, spacing, color);
     return true;
@@ -13,12 +13,35 @@ inline std::string format(const char* fmt, Args... args) {
     return str;
 }
 
+// what a widget's position is relative to; resolved by Layout whenever the graph is resized
+enum class LayoutAnchor {
+    SCREEN,
+    GRAPH_TOP_LEFT,
+    GRAPH_TOP_RIGHT,
+    GRAPH_BOTTOM_LEFT,
+    GRAPH_BOTTOM_RIGHT,
+};
+
 bool IsPointInRect(const Vector2& pointPos, const Vector2& rectPos, const Vector2& rectSize);
 
+bool IsPointInRect(const Vector2& pointPos, const Rectangle& rect);
+
 bool IsPointInCircle(const Vector2& pointPos, const Vector2& circleCenter, float circleRadius);
 
+// Loads only the glyph metrics of a font, without the atlas texture, so it works without a window.
+// Gives the same metrics as LoadFontEx for the same file and size; free with UnloadFontMetrics.
+Font LoadFontMetrics(const char* path, int fontSize);
+void UnloadFontMetrics(Font& font);
+
+// Size of a single line of text at the font's base size, like MeasureTextEx. raylib measures text as
+// empty when the font has no texture, so widgets are sized with this to lay out the same without a window.
+Vector2 MeasureTextLine(const Font& font, const std::string& text, float spacing);
+
 bool DrawTextAnchor(const Font& font, const std::string& msg, const Vector2& pos, int anchorX, int anchorY, Color color);
 
+// same as above, but with the text size already measured by the caller
+bool DrawTextAnchor(const Font& font, const std::string& msg, const Vector2& pos, const Vector2& textSize, int anchorX, int anchorY, Color color);
+
 void DrawTextCenter(const Font& font, const std::string& msg, const Vector2& pos, Color color);
 
 void DrawTextRightAlign(const Font& font, const std::string& msg, const Vector2& pos, Color color);